@@ -0,0 +1,673 @@
+///
+/// \file   Benchmark.cpp
+/// \brief  The 'nelobin_bench' program, which times the library's core operations on synthetic registries.
+///
+/// Each workload builds a registry of a given shape, scaled to roughly the
+/// requested size when saved in the standard layout. The program then times
+/// the buffer primitives, entry lookup, key creation, and saving and loading
+/// files, and reports the time and number of heap allocations per operation.
+///
+/// Every workload is generated from a fixed seed, so runs on the same build
+/// are directly comparable. Pass '--json' to print the results as JSON.
+///
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <new>
+#include <random>
+#include <Nelobin/Registry.hpp>
+
+// Count every heap allocation made by the program, and by the library.
+//
+// Every form of 'new' and 'delete' is replaced, and all of them go through the
+// one pair of functions below. Those are kept out of line, so the compiler
+// never pairs a 'new' it can see with the 'free' inside them.
+#if defined(_MSC_VER)
+# define _NelobinBench_NoInline __declspec(noinline)
+#else
+# define _NelobinBench_NoInline __attribute__((noinline))
+#endif
+
+static std::atomic<Nelobin::Size> G_ALLOCATIONS { 0 };
+
+///
+/// \fn     allocate
+/// \brief  Allocates and counts a block of memory, aligned as given.
+///
+/// Blocks aligned more strictly than 'malloc' guarantees are over-allocated,
+/// with the address 'malloc' returned kept just before the aligned block.
+///
+/// \return The block, or null if it could not be allocated.
+///
+static _NelobinBench_NoInline void* allocate (std::size_t a_size, const std::size_t a_alignment)
+{
+    G_ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+
+    if (a_size == 0)
+        a_size = 1;
+
+    if (a_alignment <= alignof(std::max_align_t))
+        return std::malloc(a_size);
+
+    void* lp_block = std::malloc(a_size + a_alignment + sizeof(void*));
+    if (lp_block == nullptr)
+        return nullptr;
+
+    const std::uintptr_t l_start = reinterpret_cast<std::uintptr_t>(lp_block) + sizeof(void*);
+    void* lp_aligned = reinterpret_cast<void*>((l_start + a_alignment - 1) & ~(a_alignment - 1));
+    static_cast<void**>(lp_aligned)[-1] = lp_block;
+    return lp_aligned;
+}
+
+///
+/// \fn     release
+/// \brief  Frees a block of memory returned by 'allocate' with the same alignment.
+///
+static _NelobinBench_NoInline void release (void* ap_memory, const std::size_t a_alignment) noexcept
+{
+    if (ap_memory != nullptr && a_alignment > alignof(std::max_align_t))
+        ap_memory = static_cast<void**>(ap_memory)[-1];
+
+    std::free(ap_memory);
+}
+
+///
+/// \fn     allocateOrThrow
+/// \brief  Allocates a block of memory as the throwing forms of 'new' do.
+///
+static inline void* allocateOrThrow (const std::size_t a_size, const std::size_t a_alignment)
+{
+    void* lp_memory = allocate(a_size, a_alignment);
+    if (lp_memory == nullptr)
+        throw std::bad_alloc {};
+
+    return lp_memory;
+}
+
+static const std::size_t G_DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+void* operator new (std::size_t a_size) { return allocateOrThrow(a_size, G_DEFAULT_ALIGNMENT); }
+void* operator new[] (std::size_t a_size) { return allocateOrThrow(a_size, G_DEFAULT_ALIGNMENT); }
+void* operator new (std::size_t a_size, std::align_val_t a_alignment) { return allocateOrThrow(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new[] (std::size_t a_size, std::align_val_t a_alignment) { return allocateOrThrow(a_size, static_cast<std::size_t>(a_alignment)); }
+
+void* operator new (std::size_t a_size, const std::nothrow_t&) noexcept { return allocate(a_size, G_DEFAULT_ALIGNMENT); }
+void* operator new[] (std::size_t a_size, const std::nothrow_t&) noexcept { return allocate(a_size, G_DEFAULT_ALIGNMENT); }
+void* operator new (std::size_t a_size, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { return allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+void* operator new[] (std::size_t a_size, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { return allocate(a_size, static_cast<std::size_t>(a_alignment)); }
+
+void operator delete (void* ap_memory) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+void operator delete[] (void* ap_memory) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+void operator delete (void* ap_memory, std::size_t) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+void operator delete[] (void* ap_memory, std::size_t) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+void operator delete (void* ap_memory, const std::nothrow_t&) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+void operator delete[] (void* ap_memory, const std::nothrow_t&) noexcept { release(ap_memory, G_DEFAULT_ALIGNMENT); }
+
+void operator delete (void* ap_memory, std::align_val_t a_alignment) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+void operator delete[] (void* ap_memory, std::align_val_t a_alignment) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+void operator delete (void* ap_memory, std::size_t, std::align_val_t a_alignment) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+void operator delete[] (void* ap_memory, std::size_t, std::align_val_t a_alignment) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+void operator delete (void* ap_memory, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+void operator delete[] (void* ap_memory, std::align_val_t a_alignment, const std::nothrow_t&) noexcept { release(ap_memory, static_cast<std::size_t>(a_alignment)); }
+
+namespace NelobinBench
+{
+
+    using namespace Nelobin;
+
+    ///
+    /// \struct Options
+    /// \brief  The program's command line options.
+    ///
+    struct Options
+    {
+        Size                    m_minSize = 1024;               ///< The size of the smallest registries.
+        Size                    m_maxSize = 32 * 1024 * 1024;   ///< The size of the largest registries.
+        Size                    m_repeat = 5;                   ///< The number of times each operation is timed.
+        Boolean                 m_json = false;                 ///< Print the results as JSON?
+        String                  m_filter;                       ///< Only run workloads with this name, if set.
+        std::filesystem::path   m_directory;                    ///< Where the registry files are written.
+    };
+
+    ///
+    /// \struct Result
+    /// \brief  The timing of one operation on one workload.
+    ///
+    struct Result
+    {
+        String      m_workload;         ///< The workload's name.
+        Size        m_size;             ///< The requested size of the workload.
+        Size        m_bytes;            ///< The number of bytes processed by each run.
+        String      m_operation;        ///< The operation's name.
+        Size        m_operations;       ///< The number of operations in each run.
+        double      m_seconds;          ///< The median time taken by a run.
+        Size        m_allocations;      ///< The number of allocations made by the median run.
+    };
+
+    ///
+    /// \struct Workload
+    /// \brief  Builds registries of one shape.
+    ///
+    /// A workload is built from a number of units, each of which adds a few keys
+    /// and entries. When 'a_entries' is false, only the keys are added. No key
+    /// has more than 1024 children, since children are found by linear search.
+    ///
+    struct Workload
+    {
+        String                                              m_name;         ///< The workload's name.
+        std::function<void (Key&, Size, Boolean, std::mt19937&)> m_build;   ///< Adds the given unit to a registry.
+    };
+
+    static const U32 G_SEED = 0x4E656C6F;
+    static const Size G_FANOUT = 1024;
+
+    ///
+    /// \fn     makeString
+    /// \brief  Makes a string of random letters, of a length within the given range.
+    ///
+    static String makeString (std::mt19937& a_random,
+                              const Size a_min,
+                              const Size a_max)
+    {
+        std::uniform_int_distribution<Size> l_length { a_min, a_max };
+        std::uniform_int_distribution<int> l_letter { 'a', 'z' };
+
+        String l_string(l_length(a_random), ' ');
+        for (char& l_char : l_string)
+            l_char = static_cast<char>(l_letter(a_random));
+
+        return l_string;
+    }
+
+    ///
+    /// \fn     getWorkloads
+    /// \brief  Gets the list of workloads.
+    ///
+    static std::vector<Workload> getWorkloads ()
+    {
+        std::vector<Workload> l_workloads;
+
+        // Keys with many differently-named entries.
+        l_workloads.push_back({ "wide", [] (Key& a_root, Size a_unit, Boolean a_entries, std::mt19937& a_random)
+        {
+            Key& l_table = a_root.addKey("Table" + std::to_string(a_unit));
+            if (a_entries == false)
+                return;
+
+            for (Size i = 0; i < G_FANOUT; ++i)
+                l_table.addEntry<U32>("Field" + std::to_string(i)).set(a_random());
+        } });
+
+        // Chains of nested keys.
+        l_workloads.push_back({ "deep", [] (Key& a_root, Size a_unit, Boolean a_entries, std::mt19937& a_random)
+        {
+            Key* lp_level = &a_root.addKey("Chain" + std::to_string(a_unit));
+            for (S32 i = 0; i < 64; ++i)
+            {
+                lp_level = &lp_level->addKey("Level");
+                if (a_entries == true)
+                {
+                    lp_level->addEntry<S32>("Depth").set(i);
+                    lp_level->addEntry<String>("Tag").set(makeString(a_random, 4, 12));
+                }
+            }
+        } });
+
+        // Many subkeys of the same name.
+        l_workloads.push_back({ "instances", [] (Key& a_root, Size a_unit, Boolean a_entries, std::mt19937& a_random)
+        {
+            Key& l_group = a_root.addKey("Group" + std::to_string(a_unit));
+            std::uniform_real_distribution<Float> l_weight { 0.0f, 1.0f };
+
+            for (Size i = 0; i < G_FANOUT; ++i)
+            {
+                Key& l_item = l_group.addKey("Item");
+                if (a_entries == true)
+                {
+                    l_item.addEntry<U16>("Id").set(static_cast<U16>(i));
+                    l_item.addEntry<Float>("Weight").set(l_weight(a_random));
+                }
+            }
+        } });
+
+        // Mostly string data.
+        l_workloads.push_back({ "strings", [] (Key& a_root, Size a_unit, Boolean a_entries, std::mt19937& a_random)
+        {
+            Key& l_document = a_root.addKey("Document" + std::to_string(a_unit));
+            if (a_entries == false)
+                return;
+
+            for (Size i = 0; i < 64; ++i)
+                l_document.addEntry<String>("Line" + std::to_string(i)).set(makeString(a_random, 16, 256));
+        } });
+
+        // Mostly numeric data, of every width.
+        l_workloads.push_back({ "numbers", [] (Key& a_root, Size a_unit, Boolean a_entries, std::mt19937& a_random)
+        {
+            Key& l_sample = a_root.addKey("Sample" + std::to_string(a_unit));
+            if (a_entries == false)
+                return;
+
+            for (Size i = 0; i < 16; ++i)
+            {
+                const String l_suffix = std::to_string(i);
+                l_sample.addEntry<S8>("Byte" + l_suffix).set(static_cast<S8>(a_random()));
+                l_sample.addEntry<U16>("Short" + l_suffix).set(static_cast<U16>(a_random()));
+                l_sample.addEntry<S32>("Integer" + l_suffix).set(static_cast<S32>(a_random()));
+                l_sample.addEntry<Float>("Float" + l_suffix).set(static_cast<Float>(a_random()) / 7.0f);
+            }
+        } });
+
+        return l_workloads;
+    }
+
+    ///
+    /// \fn     getSavedSize
+    /// \brief  Gets the size of the given registry, when saved in the standard layout.
+    ///
+    static Size getSavedSize (const Registry& a_registry)
+    {
+        Buffer l_buffer;
+        a_registry.saveToBuffer(l_buffer);
+        return l_buffer.getSize();
+    }
+
+    ///
+    /// \fn     lookUp
+    /// \brief  Looks up an entry of the given type.
+    ///
+    static void lookUp (Key& a_key,
+                        const String& a_name,
+                        const U8 a_alias)
+    {
+        switch (a_alias)
+        {
+        case Datatypes::SignedByte:         a_key.getEntry<S8>(a_name); break;
+        case Datatypes::SignedShort:        a_key.getEntry<S16>(a_name); break;
+        case Datatypes::SignedInteger:      a_key.getEntry<S32>(a_name); break;
+        case Datatypes::UnsignedByte:       a_key.getEntry<U8>(a_name); break;
+        case Datatypes::UnsignedShort:      a_key.getEntry<U16>(a_name); break;
+        case Datatypes::UnsignedInteger:    a_key.getEntry<U32>(a_name); break;
+        case Datatypes::FloatingPoint:      a_key.getEntry<Float>(a_name); break;
+        case Datatypes::StringLiteral:      a_key.getEntry<String>(a_name); break;
+        default:                            break;
+        }
+    }
+
+    ///
+    /// \fn     build
+    /// \brief  Builds the given number of units of a workload into a registry.
+    ///
+    static void build (const Workload& a_workload,
+                       Registry& a_registry,
+                       const Size a_units,
+                       const Boolean a_entries)
+    {
+        // Instance keys are grouped under parents, so that no key grows too wide.
+        std::mt19937 l_random { G_SEED };
+        Key* lp_parent = &a_registry;
+
+        for (Size i = 0; i < a_units; ++i)
+        {
+            if (i % G_FANOUT == 0)
+                lp_parent = &a_registry.addKey("Shard");
+
+            a_workload.m_build(*lp_parent, i, a_entries, l_random);
+        }
+    }
+
+    ///
+    /// \fn     measure
+    /// \brief  Runs the given function a number of times, and records the median run.
+    ///
+    /// \param  a_setup     Run before each timed run, untimed.
+    /// \param  a_run       The function to time.
+    ///
+    static void measure (const Options& a_options,
+                         Result& a_result,
+                         const std::function<void ()>& a_setup,
+                         const std::function<void ()>& a_run)
+    {
+        std::vector<std::pair<double, Size>> l_runs;
+
+        for (Size i = 0; i < a_options.m_repeat; ++i)
+        {
+            if (a_setup)
+                a_setup();
+
+            const Size l_allocations = G_ALLOCATIONS.load(std::memory_order_relaxed);
+            const auto l_start = std::chrono::steady_clock::now();
+
+            a_run();
+
+            const auto l_end = std::chrono::steady_clock::now();
+            l_runs.emplace_back(std::chrono::duration<double>(l_end - l_start).count(),
+                                G_ALLOCATIONS.load(std::memory_order_relaxed) - l_allocations);
+        }
+
+        std::sort(l_runs.begin(), l_runs.end());
+        a_result.m_seconds = l_runs[l_runs.size() / 2].first;
+        a_result.m_allocations = l_runs[l_runs.size() / 2].second;
+    }
+
+    ///
+    /// \fn     benchBuffer
+    /// \brief  Times writing and reading integers and strings through a buffer.
+    ///
+    static void benchBuffer (const Options& a_options,
+                             const Size a_size,
+                             std::vector<Result>& a_results)
+    {
+        // Integers.
+        {
+            const Size l_count = std::max<Size>(1, a_size / sizeof(U32));
+            Buffer l_source;
+
+            Result l_write { "buffer-u32", a_size, l_count * sizeof(U32), "writeData", l_count, 0, 0 };
+            measure(a_options, l_write, [&] () { l_source.clear(); }, [&] ()
+            {
+                for (Size i = 0; i < l_count; ++i)
+                    l_source.writeData<U32>(static_cast<U32>(i));
+            });
+
+            std::unique_ptr<Buffer> lp_buffer;
+            Result l_read { "buffer-u32", a_size, l_count * sizeof(U32), "readData", l_count, 0, 0 };
+            measure(a_options, l_read, [&] () { lp_buffer.reset(new Buffer { l_source.getData(), l_source.getSize() }); }, [&] ()
+            {
+                U32 l_value = 0;
+                for (Size i = 0; i < l_count; ++i)
+                    lp_buffer->readData<U32>(l_value);
+            });
+
+            a_results.push_back(l_write);
+            a_results.push_back(l_read);
+        }
+
+        // Strings.
+        {
+            std::mt19937 l_random { G_SEED };
+            std::vector<String> l_strings;
+            Size l_bytes = 0;
+
+            while (l_bytes < a_size)
+            {
+                l_strings.push_back(makeString(l_random, 8, 64));
+                l_bytes += sizeof(U32) + l_strings.back().size();
+            }
+
+            Buffer l_source;
+
+            Result l_write { "buffer-string", a_size, l_bytes, "writeData", l_strings.size(), 0, 0 };
+            measure(a_options, l_write, [&] () { l_source.clear(); }, [&] ()
+            {
+                for (const String& l_string : l_strings)
+                    l_source.writeData<String>(l_string);
+            });
+
+            std::unique_ptr<Buffer> lp_buffer;
+            Result l_read { "buffer-string", a_size, l_bytes, "readData", l_strings.size(), 0, 0 };
+            measure(a_options, l_read, [&] () { lp_buffer.reset(new Buffer { l_source.getData(), l_source.getSize() }); }, [&] ()
+            {
+                String l_value;
+                for (Size i = 0; i < l_strings.size(); ++i)
+                    lp_buffer->readData<String>(l_value);
+            });
+
+            a_results.push_back(l_write);
+            a_results.push_back(l_read);
+        }
+    }
+
+    ///
+    /// \fn     benchWorkload
+    /// \brief  Times key creation, entry lookup, and saving and loading, on one workload of one size.
+    ///
+    static void benchWorkload (const Options& a_options,
+                               const Workload& a_workload,
+                               const Size a_size,
+                               std::vector<Result>& a_results)
+    {
+        // Scale the workload by the size of a single unit.
+        Size l_units = 1;
+        {
+            Registry l_sample;
+            build(a_workload, l_sample, 1, true);
+            l_units = std::max<Size>(1, a_size / getSavedSize(l_sample));
+        }
+
+        Registry l_registry;
+        build(a_workload, l_registry, l_units, true);
+
+        const Size l_bytes = getSavedSize(l_registry);
+
+        // Gather every entry, then look a sample of them up by name.
+        struct Lookup
+        {
+            Key*    mp_key;
+            String  m_name;
+            U8      m_alias;
+        };
+
+        std::vector<Lookup> l_entries;
+        std::function<void (Key&)> l_gather = [&] (Key& a_key)
+        {
+            for (Size i = 0; i < a_key.getEntryCount(); ++i)
+            {
+                const EntryBase& l_entry = a_key.getEntryBaseAt(i);
+                l_entries.push_back({ &a_key, l_entry.getName(), l_entry.getAlias() });
+            }
+
+            for (Size i = 0; i < a_key.getKeyCount(); ++i)
+                l_gather(a_key.getKey(i));
+        };
+        l_gather(l_registry);
+
+        std::mt19937 l_random { G_SEED };
+        std::shuffle(l_entries.begin(), l_entries.end(), l_random);
+        l_entries.resize(std::min<Size>(l_entries.size(), 100000));
+
+        Result l_lookup { a_workload.m_name, a_size, 0, "getEntry", l_entries.size(), 0, 0 };
+        measure(a_options, l_lookup, nullptr, [&] ()
+        {
+            for (const Lookup& l_entry : l_entries)
+                lookUp(*l_entry.mp_key, l_entry.m_name, l_entry.m_alias);
+        });
+
+        // Build the workload's keys alone.
+        Size l_keys = 0;
+        std::unique_ptr<Registry> lp_skeleton;
+        std::function<void (const Key&)> l_count = [&] (const Key& a_key)
+        {
+            l_keys += a_key.getKeyCount();
+            for (Size i = 0; i < a_key.getKeyCount(); ++i)
+                l_count(a_key.getKey(i));
+        };
+        l_count(l_registry);
+
+        Result l_add { a_workload.m_name, a_size, 0, "addKey", l_keys, 0, 0 };
+        measure(a_options, l_add, [&] () { lp_skeleton.reset(new Registry {}); }, [&] ()
+        {
+            build(a_workload, *lp_skeleton, l_units, false);
+        });
+        lp_skeleton.reset();
+
+        // Save and load a file.
+        const String l_filename = (a_options.m_directory / ("nelobin_bench_" + a_workload.m_name + ".nbf")).string();
+
+        Result l_save { a_workload.m_name, a_size, l_bytes, "saveToFile", 1, 0, 0 };
+        measure(a_options, l_save, nullptr, [&] () { l_registry.saveToFile(l_filename); });
+
+        std::unique_ptr<Registry> lp_loaded;
+        Result l_load { a_workload.m_name, a_size, l_bytes, "loadFromFile", 1, 0, 0 };
+        measure(a_options, l_load, [&] () { lp_loaded.reset(new Registry {}); }, [&] ()
+        {
+            lp_loaded->loadFromFile(l_filename);
+        });
+        lp_loaded.reset();
+
+        std::error_code l_error;
+        std::filesystem::remove(l_filename, l_error);
+
+        a_results.push_back(l_lookup);
+        a_results.push_back(l_add);
+        a_results.push_back(l_save);
+        a_results.push_back(l_load);
+    }
+
+    ///
+    /// \fn     parseSize
+    /// \brief  Parses a size, in bytes, with an optional 'K', 'M' or 'G' suffix.
+    ///
+    static Boolean parseSize (const char* ap_text,
+                              Size& a_size)
+    {
+        char* lp_end = nullptr;
+        unsigned long long l_value = std::strtoull(ap_text, &lp_end, 10);
+        if (lp_end == ap_text)
+            return false;
+
+        switch (*lp_end)
+        {
+        case 'K': case 'k':     l_value <<= 10; ++lp_end; break;
+        case 'M': case 'm':     l_value <<= 20; ++lp_end; break;
+        case 'G': case 'g':     l_value <<= 30; ++lp_end; break;
+        default:                break;
+        }
+
+        a_size = static_cast<Size>(l_value);
+        return *lp_end == '\0' && a_size != 0;
+    }
+
+    ///
+    /// \fn     printJson
+    /// \brief  Prints the results as a JSON document.
+    ///
+    static void printJson (const Options& a_options,
+                           const std::vector<Result>& a_results)
+    {
+        std::printf("{\n  \"seed\": %u,\n  \"repeat\": %zu,\n  \"results\": [\n", G_SEED, a_options.m_repeat);
+
+        for (Size i = 0; i < a_results.size(); ++i)
+        {
+            const Result& l_result = a_results[i];
+            const double l_seconds = std::max(l_result.m_seconds, 1e-9);
+
+            std::printf("    { \"workload\": \"%s\", \"size\": %zu, \"bytes\": %zu, \"operation\": \"%s\", "
+                        "\"operations\": %zu, \"ns_per_op\": %.3f, \"mb_per_s\": %.3f, \"allocs_per_op\": %.3f }%s\n",
+                        l_result.m_workload.c_str(), l_result.m_size, l_result.m_bytes, l_result.m_operation.c_str(),
+                        l_result.m_operations, l_seconds * 1e9 / l_result.m_operations,
+                        l_result.m_bytes / l_seconds / (1024.0 * 1024.0),
+                        static_cast<double>(l_result.m_allocations) / l_result.m_operations,
+                        (i + 1 < a_results.size()) ? "," : "");
+        }
+
+        std::printf("  ]\n}\n");
+    }
+
+    ///
+    /// \fn     printRow
+    /// \brief  Prints a result as a row of a table.
+    ///
+    static void printRow (const Result& a_result)
+    {
+        const double l_seconds = std::max(a_result.m_seconds, 1e-9);
+
+        std::printf("%-14s %10zu %-13s %12.1f ns/op", a_result.m_workload.c_str(), a_result.m_size,
+                    a_result.m_operation.c_str(), l_seconds * 1e9 / a_result.m_operations);
+
+        if (a_result.m_bytes != 0)
+            std::printf(" %10.1f MB/s", a_result.m_bytes / l_seconds / (1024.0 * 1024.0));
+        else
+            std::printf(" %15s", "");
+
+        std::printf(" %10.2f allocs/op\n", static_cast<double>(a_result.m_allocations) / a_result.m_operations);
+        std::fflush(stdout);
+    }
+
+    static void printUsage ()
+    {
+        std::fprintf(stderr,
+            "Usage: nelobin_bench [options]\n"
+            "  --json               Print the results as JSON.\n"
+            "  --min-size <size>    The size of the smallest registries. Default: 1K.\n"
+            "  --max-size <size>    The size of the largest registries. Default: 32M.\n"
+            "  --repeat <count>     The number of times each operation is timed. Default: 5.\n"
+            "  --workload <name>    Only run the named workload: buffer, wide, deep, instances, strings or numbers.\n"
+            "  --dir <path>         Where to write registry files. Default: the temporary directory.\n"
+            "Sizes take an optional K, M or G suffix. They grow by a factor of 32 from the smallest.\n");
+    }
+
+}
+
+int main (int argc, char** argv)
+{
+    using namespace NelobinBench;
+
+    Options l_options;
+    l_options.m_directory = std::filesystem::temp_directory_path();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const String l_argument = argv[i];
+        const Boolean l_hasValue = (i + 1 < argc);
+
+        if (l_argument == "--json")
+            l_options.m_json = true;
+        else if (l_argument == "--min-size" && l_hasValue == true && parseSize(argv[i + 1], l_options.m_minSize) == true)
+            ++i;
+        else if (l_argument == "--max-size" && l_hasValue == true && parseSize(argv[i + 1], l_options.m_maxSize) == true)
+            ++i;
+        else if (l_argument == "--repeat" && l_hasValue == true && parseSize(argv[i + 1], l_options.m_repeat) == true)
+            ++i;
+        else if (l_argument == "--workload" && l_hasValue == true)
+            l_options.m_filter = argv[++i];
+        else if (l_argument == "--dir" && l_hasValue == true)
+            l_options.m_directory = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // The lookups are expected to succeed, so don't report the ones that don't.
+    setDiagnosticHandler(nullptr);
+
+    const std::vector<Workload> l_workloads = getWorkloads();
+    std::vector<Result> l_results;
+
+    for (Size l_size = l_options.m_minSize; l_size <= l_options.m_maxSize; l_size *= 32)
+    {
+        const Size l_first = l_results.size();
+
+        if (l_options.m_filter.empty() == true || l_options.m_filter == "buffer")
+            benchBuffer(l_options, l_size, l_results);
+
+        for (const Workload& l_workload : l_workloads)
+        {
+            if (l_options.m_filter.empty() == false && l_options.m_filter != l_workload.m_name)
+                continue;
+
+            benchWorkload(l_options, l_workload, l_size, l_results);
+        }
+
+        if (l_options.m_json == false)
+        {
+            for (Size i = l_first; i < l_results.size(); ++i)
+                printRow(l_results[i]);
+        }
+    }
+
+    if (l_options.m_json == true)
+        printJson(l_options, l_results);
+
+    return 0;
+}
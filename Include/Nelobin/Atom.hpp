@@ -0,0 +1,107 @@
+///
+/// \file   Atom.hpp
+/// \brief  Interned names for keys and entries.
+///
+
+#pragma once
+
+#include <Nelobin/Types.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    // Reserved Atom IDs
+    //
+    // These names are interned before any others, so their IDs are fixed.
+    const U32 G_EMPTY_ATOM  = 0;        ///< The empty name, "".
+    const U32 G_NULL_ATOM   = 1;        ///< The reserved name, "null".
+    const U32 G_ROOT_ATOM   = 2;        ///< The reserved name, "root".
+
+    ///
+    /// \class  Atom
+    /// \brief  A name, interned into the library's global atom table.
+    ///
+    /// Each distinct name is stored once in the atom table, and an atom is just
+    /// that name's index into the table. Comparing two atoms compares two integers.
+    ///
+    /// The atom table is shared by every registry, and is safe to use from any
+    /// number of threads. Looking a name up, through 'probe' or an existing name
+    /// passed to 'intern', takes no lock; only adding a name does.
+    ///
+    /// Interned names are never removed from the table, so its memory grows
+    /// with every distinct name the process ever sees: each key and entry name
+    /// loaded, each name passed to 'rename', and each member name in JSON read
+    /// by 'readJson'. Bound the size of untrusted input before loading it, as
+    /// that is all that bounds the names it can add.
+    ///
+    class _NELOBIN_API Atom
+    {
+    private:
+        U32     m_id;           ///< The name's index into the atom table.
+
+    private:
+        ///
+        /// \brief  Constructs an atom from the given index.
+        ///
+        /// \param  a_id        The index into the atom table.
+        ///
+        explicit Atom (const U32 a_id) :
+            m_id    { a_id }
+        {}
+
+    public:
+        ///
+        /// \brief  The default constructor. Constructs the empty name.
+        ///
+        Atom () :
+            m_id    { G_EMPTY_ATOM }
+        {}
+
+    public:
+        ///
+        /// \fn     intern
+        /// \brief  Gets the atom for the given name, adding it to the atom table if needed.
+        ///
+        /// \param  a_name      The name to intern.
+        ///
+        /// \return The name's atom.
+        ///
+        static Atom intern (const String& a_name);
+
+        ///
+        /// \fn     probe
+        /// \brief  Gets the atom for the given name, without adding it to the atom table.
+        ///
+        /// If a name was never interned, then no key or entry can bear it, so lookups
+        /// by name use this method and can stop early when it fails.
+        ///
+        /// \param  a_name      The name to look for.
+        /// \param  a_atom      Filled with the name's atom, if it is found.
+        ///
+        /// \return True if the name has been interned.
+        ///
+        static Boolean probe (const String& a_name,
+                              Atom& a_atom);
+
+        ///
+        /// \fn     getString
+        /// \brief  Gets the name this atom stands for.
+        ///
+        /// The string returned lives as long as the program does.
+        ///
+        /// \return The atom's name.
+        ///
+        const String& getString () const;
+
+    public:
+        inline U32 getID () const { return m_id; }
+        inline Boolean isEmpty () const { return m_id == G_EMPTY_ATOM; }
+        inline Boolean isReserved () const { return m_id == G_NULL_ATOM || m_id == G_ROOT_ATOM; }
+
+        inline Boolean operator== (const Atom& a_other) const { return m_id == a_other.m_id; }
+        inline Boolean operator!= (const Atom& a_other) const { return m_id != a_other.m_id; }
+
+    };
+
+}
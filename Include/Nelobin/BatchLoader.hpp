@@ -0,0 +1,60 @@
+///
+/// \file   BatchLoader.hpp
+/// \brief  Loads many registry files at once.
+///
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <Nelobin/Registry.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  BatchLoader
+    /// \brief  Loads many registry files at once.
+    ///
+    /// Loading lots of small files one at a time spends most of its time in
+    /// system calls - opening, sizing, reading and closing each file in turn -
+    /// rather than in parsing them. The batch loader instead submits those
+    /// operations for a whole batch of files together, through io_uring, so
+    /// that the kernel can work on them all at once with only a handful of
+    /// system calls. Each file is parsed on the default executor as soon as it
+    /// has been read, while the rest are still being read.
+    ///
+    /// Where io_uring isn't available - on other platforms, on kernels older
+    /// than 5.6, or where it has been disabled - the files are read and parsed
+    /// on the default executor instead. The results are the same either way.
+    ///
+    /// Don't load a batch from a task running on the default executor.
+    ///
+    class _NELOBIN_API BatchLoader
+    {
+    public:
+        ///
+        /// \fn     load
+        /// \brief  Loads each of the given files into a registry of its own.
+        ///
+        /// \param  a_filenames     The names of the files to load.
+        /// \param  a_registries    Filled with one registry per file, in the same order. The
+        ///                         registry of a file which fails to load is left empty.
+        /// \param  a_useRing       Optional. Set to false to load without io_uring, even if it is available.
+        ///
+        /// \return One status code per file, in the same order.
+        ///
+        static std::vector<Status> load (const std::vector<String>& a_filenames,
+                                         std::vector<std::unique_ptr<Registry>>& a_registries,
+                                         const Boolean a_useRing = true);
+
+        ///
+        /// \fn     isRingAvailable
+        /// \brief  Checks to see if batches can be loaded through io_uring on this system.
+        ///
+        static Boolean isRingAvailable ();
+
+    };
+
+}
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <Nelobin/Counters.hpp>
 #include <Nelobin/Error.hpp>
 #include <Nelobin/Types.hpp>
+#include <Nelobin/Atom.hpp>
 #include <Nelobin/Order.hpp>
 
 namespace Nelobin
@@ -21,6 +24,10 @@ namespace Nelobin
     private:
         ByteArray   m_bytes;        ///< The array of bytes.
         Size        m_read;         ///< The position of the read cursor.
+        U8          m_format;       ///< The format flags used to encode integers and headers.
+        Boolean     m_trusted;      ///< Have the bytes been validated, so that reads need no bounds checks?
+        std::vector<Atom>               m_names;        ///< The name table, in index order.
+        std::unordered_map<U32, U32>    m_nameIndices;  ///< Maps atom IDs to their indices in the name table.
 
     private:
         ///
@@ -33,6 +40,9 @@ namespace Nelobin
         ///
         /// The size given is usually the return value of the sizeof operator.
         ///
+        /// A trusted buffer skips the check, since its bytes have already been
+        /// validated.
+        ///
         /// \param  a_size          The size to check.
         ///
         /// \return True if we can read the data.
@@ -54,6 +64,13 @@ namespace Nelobin
         Buffer (const void* ap_data,
                 const Size a_size);
 
+        ///
+        /// \brief  Constructs from an array of bytes, taking ownership of it.
+        ///
+        /// \param  a_bytes         The byte array.
+        ///
+        explicit Buffer (ByteArray&& a_bytes);
+
         ///
         /// \brief  The destructor.
         ///
@@ -86,6 +103,15 @@ namespace Nelobin
         ///
         void clear ();
 
+        ///
+        /// \fn     reserve
+        /// \brief  Makes room for the given number of bytes in all, so that writing
+        ///         up to that many bytes reallocates nothing.
+        ///
+        /// \param  a_size          The number of bytes to make room for.
+        ///
+        void reserve (const Size a_size);
+
         ///
         /// \fn     writeRaw
         /// \brief  Writes raw data to the byte array.
@@ -132,9 +158,180 @@ namespace Nelobin
         template <typename T>
         Buffer& readData (T& a_data);
 
+        ///
+        /// \fn     writeVarint
+        /// \brief  Writes an unsigned integer as a LEB128 variable-length integer.
+        ///
+        /// Seven bits of the integer are stored per byte, least significant group
+        /// first, with the high bit of each byte set if more bytes follow.
+        ///
+        /// \param  a_data          The integer to be written.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& writeVarint (const U32 a_data);
+
+        ///
+        /// \fn     readVarint
+        /// \brief  Reads a LEB128 variable-length integer.
+        ///
+        /// \param  a_data          Filled with the integer read.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& readVarint (U32& a_data);
+
+        ///
+        /// \fn     writeHeader
+        /// \brief  Writes an entity header in the buffer's format.
+        ///
+        /// In the standard format, the four-byte header is written as-is. In the
+        /// compact format, it is replaced with its one-byte record tag.
+        ///
+        /// \param  a_header        The header to be written.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& writeHeader (const U32 a_header);
+
+        ///
+        /// \fn     readHeader
+        /// \brief  Reads an entity header in the buffer's format.
+        ///
+        /// Record tags read in the compact format are mapped back to their
+        /// four-byte headers. Unrecognized tags yield a header of zero.
+        ///
+        /// \param  a_header        Filled with the header read.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& readHeader (U32& a_header);
+
+        ///
+        /// \fn     addName
+        /// \brief  Adds a name to the buffer's name table, if it isn't there already.
+        ///
+        /// \param  a_name          The name to add.
+        ///
+        void addName (const Atom& a_name);
+
+        ///
+        /// \fn     writeNameTable
+        /// \brief  Writes the buffer's name table: its size, then each name in index order.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& writeNameTable ();
+
+        ///
+        /// \fn     readNameTable
+        /// \brief  Reads a name table written by 'writeNameTable', replacing the current one.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& readNameTable ();
+
+        ///
+        /// \fn     writeName
+        /// \brief  Writes the name of a key or entry.
+        ///
+        /// If the 'NameTable' flag is set, the name's index in the name table is
+        /// written in place of the name itself. Otherwise, the name is written as
+        /// a string.
+        ///
+        /// \param  a_name          The name to be written. Must be in the name table, if one is used.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& writeName (const Atom& a_name);
+
+        ///
+        /// \fn     readName
+        /// \brief  Reads the name of a key or entry written by 'writeName'.
+        ///
+        /// If an index is read which is not in the name table, the name is left empty.
+        /// Names read through the name table are interned once, when the table is
+        /// read, so each name read afterwards is a single array access.
+        ///
+        /// \param  a_name          Filled with the name read.
+        ///
+        /// \return This byte buffer.
+        ///
+        Buffer& readName (Atom& a_name);
+
     public:
+        ///
+        /// \fn     getDataSize
+        /// \brief  Gets the number of bytes 'writeData' takes to write the given data,
+        ///         in the buffer's current format.
+        ///
+        /// \param  a_data          The data in question.
+        ///
+        /// \return The size of the data, as written.
+        ///
+        template <typename T>
+        Size getDataSize (const T& a_data) const;
+
+        ///
+        /// \fn     getHeaderSize
+        /// \brief  Gets the number of bytes 'writeHeader' takes to write a header.
+        ///
+        Size getHeaderSize () const;
+
+        ///
+        /// \fn     getNameSize
+        /// \brief  Gets the number of bytes 'writeName' takes to write the given name.
+        ///
+        /// \param  a_name          The name in question. Must be in the name table, if one is used.
+        ///
+        Size getNameSize (const Atom& a_name) const;
+
+        ///
+        /// \fn     getVarintSize
+        /// \brief  Gets the number of bytes 'writeVarint' takes to write the given integer.
+        ///
+        /// \param  a_data          The integer in question.
+        ///
+        /// \return The size of the integer's variable-length form.
+        ///
+        static inline Size getVarintSize (const U32 a_data)
+        {
+            return 1 + (a_data >= (1u << 7)) + (a_data >= (1u << 14)) +
+                   (a_data >= (1u << 21)) + (a_data >= (1u << 28));
+        }
+
+        ///
+        /// \fn     setFormat
+        /// \brief  Sets the format flags used when reading and writing data.
+        ///
+        /// When the 'Compact' flag is set, 16- and 32-bit integers and string
+        /// lengths are written as variable-length integers (signed types are
+        /// zig-zag encoded first), and entity headers are written as one-byte
+        /// record tags. Bytes, floats and string contents are unaffected.
+        ///
+        /// \param  a_format        The format flags. See the 'Formats' enum.
+        ///
+        void setFormat (const U8 a_format);
+
+        ///
+        /// \fn     setTrusted
+        /// \brief  Marks the buffer's bytes as validated, so that they are read without bounds checks.
+        ///
+        /// Only mark a buffer as trusted once it has passed 'Validator::validate'.
+        /// Reading past the end of a trusted buffer is undefined. Loading, writing to
+        /// or clearing the buffer marks it as untrusted again.
+        ///
+        /// \param  a_trusted       Are the bytes trusted?
+        ///
+        void setTrusted (const Boolean a_trusted);
+
         const char* getData () const;
         const Size getSize () const;
+        U8 getFormat () const;
+        bool isCompact () const;
+        bool hasNameTable () const;
+        bool isTrusted () const;
+        Size getRemaining () const;
         bool isEmpty () const;
 
     };
@@ -0,0 +1,159 @@
+///
+/// \file   Counters.hpp
+/// \brief  Performance counters, which tally what the library does.
+///
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <Nelobin/Types.hpp>
+#include <Nelobin/Export.hpp>
+
+///
+/// \def    _Nelobin_Count
+/// \brief  Adds the given amount to one of the library's performance counters.
+///
+/// \def    _Nelobin_Time
+/// \brief  Adds the time taken by the rest of the enclosing scope, in nanoseconds, to a counter.
+///
+/// Counters are only updated when 'NELOBIN_COUNTERS' is defined. Otherwise,
+/// these macros expand to nothing, and their arguments are not evaluated.
+/// Projects using the library should define the same macro as the library was
+/// built with, since some of the counted methods are defined in its headers.
+///
+#if defined(NELOBIN_COUNTERS)
+# define _Nelobin_Count(a_counter, a_amount) \
+    Nelobin::Private::G_COUNTERS[Nelobin::Counters::a_counter].m_value.fetch_add( \
+        static_cast<Nelobin::Size>(a_amount), std::memory_order_relaxed)
+# define _Nelobin_Time(a_counter) \
+    Nelobin::Private::CounterTimer l_counterTimer { Nelobin::Counters::a_counter }
+#else
+# define _Nelobin_Count(a_counter, a_amount) do { } while (false)
+# define _Nelobin_Time(a_counter) do { } while (false)
+#endif
+
+namespace Nelobin
+{
+
+    ///
+    /// \enum   Counters
+    /// \brief  Enumerates the library's performance counters.
+    ///
+    enum Counters : U8
+    {
+        EntryLookups,           ///< Calls to 'getEntry' and 'tryGetEntry'.
+        EntryMisses,            ///< Entry lookups which found no entry of the type asked for.
+        KeyLookups,             ///< Calls to 'getKey' and 'tryGetKey'.
+        KeyMisses,              ///< Key lookups which found no key.
+        EntrySeeks,             ///< Linear searches of a key's entries.
+        EntrySeekSteps,         ///< Entries compared by those searches.
+        KeySeeks,               ///< Linear searches of a key's subkeys.
+        KeySeekSteps,           ///< Subkeys compared by those searches.
+        RecordsParsed,          ///< Entries, keys and column blocks read by 'deserializeNext'.
+        BytesParsed,            ///< Bytes given to 'Registry::loadFromBuffer' to parse.
+        KeyAllocations,         ///< Keys constructed.
+        EntryAllocations,       ///< Entries constructed.
+        Loads,                  ///< Registries loaded from buffers.
+        LoadNanoseconds,        ///< Time spent loading registries from buffers.
+        Saves,                  ///< Registries saved to buffers.
+        SaveNanoseconds,        ///< Time spent saving registries to buffers.
+        FileBytesRead,          ///< Bytes read from files by 'Buffer::loadFromFile'.
+        FileReadNanoseconds,    ///< Time spent reading files.
+        FileBytesWritten,       ///< Bytes written to files by 'Buffer::saveToFile'.
+        FileWriteNanoseconds,   ///< Time spent writing files.
+        CounterCount
+    };
+
+    ///
+    /// \struct CounterSnapshot
+    /// \brief  The values of every performance counter at one point in time.
+    ///
+    /// Each counter is read atomically, but not all at the same instant, so the
+    /// counters in a snapshot taken during an operation may not agree exactly.
+    ///
+    struct CounterSnapshot
+    {
+        Size    m_values[CounterCount];     ///< The counter values, indexed by the 'Counters' enum.
+
+        inline Size get (const Counters a_counter) const { return m_values[a_counter]; }
+    };
+
+    namespace Private
+    {
+
+        ///
+        /// \struct Counter
+        /// \brief  A single counter, on a cache line of its own.
+        ///
+        struct alignas(64) Counter
+        {
+            std::atomic<Size>   m_value { 0 };
+        };
+
+        /// The counters themselves. Use the macros above to update them.
+        extern _NELOBIN_API Counter G_COUNTERS[CounterCount];
+
+        ///
+        /// \class  CounterTimer
+        /// \brief  Adds its own lifetime, in nanoseconds, to a counter.
+        ///
+        class CounterTimer
+        {
+        private:
+            Counters                                m_counter;  ///< The counter to add to.
+            std::chrono::steady_clock::time_point   m_start;    ///< When the timer was started.
+
+        public:
+            explicit CounterTimer (const Counters a_counter) :
+                m_counter   { a_counter },
+                m_start     { std::chrono::steady_clock::now() }
+            {}
+
+            ~CounterTimer ()
+            {
+                auto l_elapsed = std::chrono::steady_clock::now() - m_start;
+                G_COUNTERS[m_counter].m_value.fetch_add(
+                    static_cast<Size>(std::chrono::duration_cast<std::chrono::nanoseconds>(l_elapsed).count()),
+                    std::memory_order_relaxed);
+            }
+
+            CounterTimer (const CounterTimer&) = delete;
+            CounterTimer& operator= (const CounterTimer&) = delete;
+        };
+
+    }
+
+    ///
+    /// \fn     getCounters
+    /// \brief  Takes a snapshot of every performance counter.
+    ///
+    /// \return The snapshot.
+    ///
+    _NELOBIN_API CounterSnapshot getCounters ();
+
+    ///
+    /// \fn     resetCounters
+    /// \brief  Sets every performance counter back to zero.
+    ///
+    _NELOBIN_API void resetCounters ();
+
+    ///
+    /// \fn     getCounterName
+    /// \brief  Gets the name of the given counter, in snake case, for exporting to a metrics system.
+    ///
+    /// \param  a_counter           The counter.
+    ///
+    /// \return The counter's name, or "unknown".
+    ///
+    _NELOBIN_API const char* getCounterName (const Counters a_counter);
+
+    ///
+    /// \fn     areCountersEnabled
+    /// \brief  Checks to see if the library was built with its performance counters.
+    ///
+    /// \return True if the counters are updated.
+    ///
+    _NELOBIN_API Boolean areCountersEnabled ();
+
+}
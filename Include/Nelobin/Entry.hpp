@@ -3,6 +3,8 @@
 /// \brief  The template-specialized registry entry class.
 ///
 
+#pragma once
+
 #include <Nelobin/EntryBase.hpp>
 
 namespace Nelobin
@@ -21,7 +23,25 @@ namespace Nelobin
 
     public:
         /// A "null" entry, returned in case of errors retriving or adding.
-        static Entry<T> s_null;
+        ///
+        /// Each thread has its own "null" entry, so writes to it can't race with
+        /// other threads. Use 'getNull' rather than this member directly.
+        static thread_local Entry<T> s_null;
+
+        ///
+        /// \fn     getNull
+        /// \brief  Gets this thread's "null" entry, with its value reset.
+        ///
+        /// The value is reset on every call, so a value written to the "null"
+        /// entry after one failed lookup can't be read back after another.
+        ///
+        /// \return The "null" entry.
+        ///
+        static inline Entry<T>& getNull ()
+        {
+            s_null.m_data = T();
+            return s_null;
+        }
 
     private:
         T   m_data;             ///< The entry's value.
@@ -35,10 +55,22 @@ namespace Nelobin
         ///
         Entry (const String& a_name,
                const T& a_data = T()) :
+            EntryBase   { Atom::intern(a_name), TT_Type<T>::Alias },
+            m_data      { a_data }
+        {}
+
+        ///
+        /// \brief  Constructs an entry with an already-interned name.
+        ///
+        /// \param  a_name      The entry's name.
+        /// \param  a_data      Optional. The entry's value.
+        ///
+        Entry (const Atom& a_name,
+               const T& a_data = T()) :
             EntryBase   { a_name, TT_Type<T>::Alias },
             m_data      { a_data }
         {}
-        
+
     public:
         ///
         /// \fn     serialize
@@ -46,20 +78,43 @@ namespace Nelobin
         ///
         inline void serialize (Buffer& a_buffer) const override
         {
-            a_buffer.writeData<U32>(G_ENTRY_HEADER)
-                    .writeData<String>(m_name)
+            a_buffer.writeHeader(G_ENTRY_HEADER)
+                    .writeName(m_name)
                     .writeData<U8>(m_alias)
                     .writeData<T>(m_data);
         }
 
+        ///
+        /// \fn     getSerializedSize
+        /// \brief  Gets the number of bytes 'serialize' writes to the given buffer.
+        ///
+        inline Size getSerializedSize (const Buffer& a_buffer) const override
+        {
+            return a_buffer.getHeaderSize() + a_buffer.getNameSize(m_name) +
+                   sizeof(U8) + a_buffer.getDataSize<T>(m_data);
+        }
+
+        ///
+        /// \fn     clone
+        /// \brief  Makes a copy of this entry, value included.
+        ///
+        inline EntryBase::Ptr clone () const override
+        {
+            return EntryBase::Ptr { new Entry<T>(m_name, m_data) };
+        }
+
     public:
         ///
         /// \fn     get
         /// \brief  Gets the value of the entry.
         ///
+        /// Since the value can be changed through the reference returned by the
+        /// non-const overload, that overload counts as a change to the entry. Don't
+        /// hold on to that reference across a save; call 'set' instead.
+        ///
         /// \return The value of the entry.
         ///
-        inline T& get () { return m_data; }
+        inline T& get () { markDirty(); return m_data; }
         inline const T& get () const { return m_data; }
 
         ///
@@ -68,7 +123,7 @@ namespace Nelobin
         ///
         /// \param  a_data      The entry's value.
         ///
-        inline void set (const T& a_data) { m_data = a_data; }
+        inline void set (const T& a_data) { m_data = a_data; markDirty(); }
 
     public:
         ///
@@ -81,7 +136,7 @@ namespace Nelobin
     };
 
     template <typename T>
-    Entry<T> Entry<T>::s_null { "null" };
+    thread_local Entry<T> Entry<T>::s_null { "null" };
 
     ///
     /// \fn     stringifyEntryBase
@@ -89,7 +144,9 @@ namespace Nelobin
     ///
     /// This function takes the base form of an entry, not the entry itself.
     /// This function is intended to be used from the Key class's 'stringifyEntry'
-    /// and 'stringifyEntryAt' methods.
+    /// and 'stringifyEntryAt' methods. Floats are written in the shortest form
+    /// which reads back as the same value. To format into a string of your own,
+    /// use 'appendEntry', from "Text.hpp", instead.
     ///
     /// \param  a_entry         The entry to be stringified. Remember - base entries only!
     ///
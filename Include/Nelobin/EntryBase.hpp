@@ -9,12 +9,16 @@
 #include <memory>
 #include <algorithm>
 #include <Nelobin/Types.hpp>
+#include <Nelobin/Atom.hpp>
 #include <Nelobin/Buffer.hpp>
+#include <Nelobin/Counters.hpp>
 #include <Nelobin/Export.hpp>
 
 namespace Nelobin
 {
 
+    class Key;
+
     ///
     /// \class  EntryBase
     /// \brief  The base class for our templated registry entry class.
@@ -42,8 +46,28 @@ namespace Nelobin
         static EntryBase s_null;
 
     protected:
-        String           m_name;        ///< The name of the entry.
+        Atom             m_name;        ///< The name of the entry.
         U8               m_alias;       ///< The entry's type alias byte.
+        Key*             mp_owner;      ///< The key holding this entry, if any.
+
+    protected:
+        ///
+        /// \fn     markDirty
+        /// \brief  Tells the key holding this entry that its value has changed.
+        ///
+        /// The key then drops what it has cached about its serialized form.
+        ///
+        inline void markDirty ()
+        {
+            if (mp_owner != nullptr)
+                notifyOwner();
+        }
+
+        ///
+        /// \fn     notifyOwner
+        /// \brief  Passes a change to this entry's value on to the key holding it.
+        ///
+        void notifyOwner ();
 
     protected:
         ///
@@ -52,11 +76,23 @@ namespace Nelobin
         /// \param  a_name              The name of the entry.
         /// \param  a_alias             The entry's type alias byte.
         ///
-        EntryBase (const String& a_name,
+        EntryBase (const Atom& a_name,
                    const U8 a_alias) :
             m_name      { a_name },
-            m_alias     { a_alias }
-        {}
+            m_alias     { a_alias },
+            mp_owner    { nullptr }
+        {
+            _Nelobin_Count(EntryAllocations, 1);
+        }
+
+    public:
+        ///
+        /// \brief  The destructor.
+        ///
+        /// Entries are owned, and destroyed, through pointers to this base class,
+        /// so the destructor must be virtual for their values to be destroyed too.
+        ///
+        virtual ~EntryBase () = default;
 
     public:
         ///
@@ -71,10 +107,30 @@ namespace Nelobin
         ///
         virtual void serialize (Buffer& a_buffer) const { (void) a_buffer; }
 
+        ///
+        /// \fn     getSerializedSize
+        /// \brief  Gets the number of bytes 'serialize' writes to the given buffer.
+        ///
+        /// \param  a_buffer            The buffer which the entry would be serialized into.
+        ///
+        virtual Size getSerializedSize (const Buffer& a_buffer) const { (void) a_buffer; return 0; }
+
+        ///
+        /// \fn     clone
+        /// \brief  Makes a copy of this entry.
+        ///
+        /// In this base class, this method copies the name and type alias only. The
+        /// specialized entry classes also copy their values.
+        ///
+        /// \return The copy.
+        ///
+        virtual Ptr clone () const { return Ptr { new EntryBase(m_name, m_alias) }; }
+
     public:
-        inline const String& getName () const { return m_name; }
+        inline const String& getName () const { return m_name.getString(); }
+        inline const Atom& getAtom () const { return m_name; }
         inline U8 getAlias () const { return m_alias; }
-        inline Boolean isNull () const { return m_name == "null"; }
+        inline Boolean isNull () const { return m_name.getID() == G_NULL_ATOM; }
 
     };
 
@@ -6,14 +6,49 @@
 #pragma once
 
 #include <iostream>
+#include <sstream>
 #include <Nelobin/Types.hpp>
 #include <Nelobin/Export.hpp>
 
-#define _Nelobin_Error(a_msg) std::cerr << a_msg << std::endl;
+///
+/// \def    _Nelobin_Error
+/// \brief  Reports a diagnostic message to the installed diagnostic handler.
+///
+/// The message is only formatted if a handler is installed, so with no handler,
+/// a diagnostic costs a single check. Defining 'NELOBIN_NO_DIAGNOSTICS' removes
+/// diagnostics from the library entirely.
+///
+#if defined(NELOBIN_NO_DIAGNOSTICS)
+# define _Nelobin_Error(a_msg) do { } while (false)
+#else
+# define _Nelobin_Error(a_msg) \
+    do \
+    { \
+        if (Nelobin::hasDiagnosticHandler() == true) \
+        { \
+            std::ostringstream l_diagnostic; \
+            l_diagnostic << a_msg; \
+            Nelobin::reportDiagnostic(l_diagnostic.str()); \
+        } \
+    } while (false)
+#endif
 
 namespace Nelobin
 {
 
+    ///
+    /// \typedef DiagnosticHandler
+    /// \brief  A function which receives the library's diagnostic messages.
+    ///
+    /// Diagnostics are reported on the thread that caused them, so handlers which
+    /// may be called from several threads at once must be thread-safe.
+    ///
+    /// \param  a_message           The diagnostic message.
+    /// \param  ap_userData         The user data given with the handler.
+    ///
+    using DiagnosticHandler = void (*) (const String& a_message,
+                                        void* ap_userData);
+
     ///
     /// \enum   Status
     /// \brief  Enumerates function status codes.
@@ -24,7 +59,9 @@ namespace Nelobin
         NoName,
         FileLoadError,
         FileSaveError,
-        FileParseError
+        FileParseError,
+        NotFound,
+        TypeMismatch
     };
 
     ///
@@ -37,4 +74,46 @@ namespace Nelobin
     ///
     _NELOBIN_API String stringifyStatus (const Status a_status);
 
+    ///
+    /// \fn     setDiagnosticHandler
+    /// \brief  Installs the function which receives the library's diagnostic messages.
+    ///
+    /// By default, diagnostics are printed to the standard error stream by
+    /// 'printDiagnostic'. Install a null handler to silence them, in which case
+    /// no messages are formatted at all.
+    ///
+    /// The handler should be installed before the library is used from other threads.
+    ///
+    /// \param  a_handler           The handler to install, or null for none.
+    /// \param  ap_userData         Optional. Passed to the handler with each message.
+    ///
+    _NELOBIN_API void setDiagnosticHandler (DiagnosticHandler a_handler,
+                                            void* ap_userData = nullptr);
+
+    ///
+    /// \fn     hasDiagnosticHandler
+    /// \brief  Checks to see if a diagnostic handler is installed.
+    ///
+    /// \return True if a handler is installed.
+    ///
+    _NELOBIN_API Boolean hasDiagnosticHandler ();
+
+    ///
+    /// \fn     reportDiagnostic
+    /// \brief  Passes a diagnostic message to the installed handler, if any.
+    ///
+    /// \param  a_message           The diagnostic message.
+    ///
+    _NELOBIN_API void reportDiagnostic (const String& a_message);
+
+    ///
+    /// \fn     printDiagnostic
+    /// \brief  The default diagnostic handler. Prints the message to the standard error stream.
+    ///
+    /// \param  a_message           The diagnostic message.
+    /// \param  ap_userData         Unused.
+    ///
+    _NELOBIN_API void printDiagnostic (const String& a_message,
+                                       void* ap_userData);
+
 }
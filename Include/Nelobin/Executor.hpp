@@ -0,0 +1,105 @@
+///
+/// \file   Executor.hpp
+/// \brief  A pool of worker threads, on which the library runs background work.
+///
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Nelobin/Types.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  Executor
+    /// \brief  A pool of worker threads, on which the library runs background work.
+    ///
+    /// Tasks are run in the order they are submitted, by whichever worker is free.
+    /// Destroying the executor waits for every task submitted to it to finish.
+    ///
+    /// The library's asynchronous methods use the default executor, which has one
+    /// worker per hardware thread and is created the first time it is used.
+    ///
+    class _NELOBIN_API Executor
+    {
+    private:
+        std::mutex                          m_mutex;        ///< Guards the task queue.
+        std::condition_variable             m_ready;        ///< Signalled when a task is queued, or the executor stops.
+        std::deque<std::function<void ()>>  m_tasks;        ///< The tasks waiting to be run.
+        std::vector<std::thread>            m_workers;      ///< The worker threads.
+        Boolean                             m_stopping;     ///< Set when the executor is being destroyed.
+
+    private:
+        ///
+        /// \fn     work
+        /// \brief  Runs queued tasks until the executor stops. Each worker runs this.
+        ///
+        void work ();
+
+    public:
+        ///
+        /// \brief  Starts an executor with the given number of workers.
+        ///
+        /// \param  a_workers   Optional. The number of workers. Leave as zero for one per hardware thread.
+        ///
+        explicit Executor (const Size a_workers = 0);
+
+        ///
+        /// \brief  The destructor. Waits for every queued task to finish.
+        ///
+        ~Executor ();
+
+        Executor (const Executor&) = delete;
+        Executor& operator= (const Executor&) = delete;
+
+    public:
+        ///
+        /// \fn     post
+        /// \brief  Queues the given task.
+        ///
+        /// \param  a_task      The task to run.
+        ///
+        void post (std::function<void ()> a_task);
+
+        ///
+        /// \fn     submit
+        /// \brief  Queues the given function, and returns a future for its result.
+        ///
+        /// \param  a_function  The function to run.
+        ///
+        /// \return A future which receives the function's result.
+        ///
+        template <typename F>
+        inline auto submit (F&& a_function) -> std::future<decltype(a_function())>
+        {
+            using Result = decltype(a_function());
+
+            // Tasks must be copyable, so the packaged task is shared.
+            auto l_task = std::make_shared<std::packaged_task<Result ()>>(std::forward<F>(a_function));
+            std::future<Result> l_future = l_task->get_future();
+
+            post([l_task] () { (*l_task)(); });
+            return l_future;
+        }
+
+        ///
+        /// \fn     getDefault
+        /// \brief  Gets the library's default executor.
+        ///
+        static Executor& getDefault ();
+
+    public:
+        inline Size getWorkerCount () const { return m_workers.size(); }
+
+    };
+
+}
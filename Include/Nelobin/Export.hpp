@@ -14,13 +14,13 @@
 #  define _NELOBIN_API __declspec(dllimport)
 # endif
 #else
-# if defined(__GNUC__) && __GNUC__ >= 5
+# if defined(__GNUC__) && __GNUC__ >= 7
 #  if defined(_NELOBIN_BUILDING)
 #   define _NELOBIN_API __attribute__ ((visibility("default")))
 #  else
 #   define _NELOBIN_API
 #  endif
 # else
-#  error The Nelobin Library uses some C++14 features. This will at least G++ version 5.
+#  error The Nelobin Library uses some C++17 features. This will need at least G++ version 7.
 # endif
 #endif
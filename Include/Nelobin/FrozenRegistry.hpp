@@ -0,0 +1,385 @@
+///
+/// \file   FrozenRegistry.hpp
+/// \brief  An immutable, contiguous copy of a registry, for fast reads.
+///
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <Nelobin/Registry.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    class FrozenRegistry;
+
+    ///
+    /// \class  FrozenKey
+    /// \brief  A key in a frozen registry.
+    ///
+    /// Frozen keys are small handles, passed around by value. They offer the
+    /// same lookups as the const methods of the Key class, but return values
+    /// rather than entries, since a frozen registry holds no entry objects.
+    ///
+    /// A handle is valid for as long as the registry it came from. If a key or
+    /// entry is not found, a "null" handle, or a default value, is returned.
+    ///
+    class _NELOBIN_API FrozenKey
+    {
+    private:
+        friend class FrozenRegistry;
+
+    private:
+        const FrozenRegistry*   mp_registry;    ///< The registry this key belongs to, or null for the "null" key.
+        U32                     m_node;         ///< The key's index into the registry's node array.
+
+    private:
+        FrozenKey (const FrozenRegistry* ap_registry,
+                   const U32 a_node);
+
+        ///
+        /// \fn     findEntry
+        /// \brief  Finds the entry with the given name and type, without reporting anything.
+        ///
+        /// \return The entry's index into the registry's entry array, or -1.
+        ///
+        U32 findEntry (const String& a_name,
+                       const U8 a_alias) const;
+
+        ///
+        /// \fn     findKey
+        /// \brief  Finds the subkey with the given name and instance ID, without reporting anything.
+        ///
+        /// \return The subkey's index into the registry's node array, or -1.
+        ///
+        U32 findKey (const String& a_name,
+                     const U32 a_instance) const;
+
+        ///
+        /// \fn     readEntry
+        /// \brief  Gets the value of the entry at the given index.
+        ///
+        template <typename T>
+        inline T readEntry (const U32 a_entry) const;
+
+    public:
+        ///
+        /// \brief  The default constructor. Constructs the "null" key.
+        ///
+        FrozenKey ();
+
+    public:
+        ///
+        /// \fn     getEntry
+        /// \brief  Gets the value of the entry with the given name.
+        ///
+        /// \param  a_name      The name of the entry.
+        ///
+        /// \return The entry's value, or a default value if it is missing or of another type.
+        ///
+        template <typename T>
+        inline T getEntry (const String& a_name) const
+        {
+            U32 l_entry = findEntry(a_name, TT_Type<T>::Alias);
+            if (l_entry == static_cast<U32>(-1))
+            {
+                _Nelobin_Error("FrozenKey::getEntry(): In key \"" << getName() << "\":");
+                _Nelobin_Error("FrozenKey::getEntry(): Entry, \"" << a_name << "\", of type " << stringifyType(TT_Type<T>::Alias) << ", not found.");
+                return T {};
+            }
+
+            return readEntry<T>(l_entry);
+        }
+
+        ///
+        /// \fn     tryGetEntry
+        /// \brief  Gets the value of the entry with the given name, if it exists.
+        ///
+        /// Unlike 'getEntry', this method reports nothing if the entry is missing
+        /// or of another type.
+        ///
+        /// \param  a_name      The name of the entry.
+        /// \param  a_value     Filled with the entry's value, if it is found.
+        ///
+        /// \return True if the entry was found.
+        ///
+        template <typename T>
+        inline Boolean tryGetEntry (const String& a_name,
+                                    T& a_value) const
+        {
+            U32 l_entry = findEntry(a_name, TT_Type<T>::Alias);
+            if (l_entry == static_cast<U32>(-1))
+                return false;
+
+            a_value = readEntry<T>(l_entry);
+            return true;
+        }
+
+        ///
+        /// \fn     getOr
+        /// \brief  Gets the value of the entry with the given name, or a fallback value.
+        ///
+        template <typename T>
+        inline T getOr (const String& a_name,
+                        const T& a_default) const
+        {
+            U32 l_entry = findEntry(a_name, TT_Type<T>::Alias);
+            return (l_entry != static_cast<U32>(-1)) ? readEntry<T>(l_entry) : a_default;
+        }
+
+        ///
+        /// \fn     getKey
+        /// \brief  Retrieves the subkey with the given name and instance ID.
+        ///
+        /// \return The subkey found, or the "null" key.
+        ///
+        FrozenKey getKey (const String& a_name,
+                          const U32 a_instance = 0) const;
+
+        ///
+        /// \fn     tryGetKey
+        /// \brief  Retrieves the subkey with the given name and instance ID, if it exists.
+        ///
+        /// Unlike 'getKey', this method reports nothing if the subkey is missing.
+        ///
+        /// \return The subkey found, or the "null" key.
+        ///
+        FrozenKey tryGetKey (const String& a_name,
+                             const U32 a_instance = 0) const;
+
+        ///
+        /// \fn     getKey
+        /// \brief  Retrieves the subkey at the given index.
+        ///
+        /// \return The subkey found, or the "null" key.
+        ///
+        FrozenKey getKey (const Size a_index) const;
+
+        ///
+        /// \fn     getInstanceCount
+        /// \brief  Gets the number of subkeys with the given name.
+        ///
+        U32 getInstanceCount (const String& a_name) const;
+
+    public:
+        String getName () const;
+        U32 getInstanceID () const;
+        Size getEntryCount () const;
+        Size getKeyCount () const;
+        Boolean isNull () const;
+
+    };
+
+    ///
+    /// \class  FrozenRegistry
+    /// \brief  An immutable, contiguous copy of a registry, for fast reads.
+    ///
+    /// Freezing a registry packs it into a single block of memory, called its
+    /// image. The image holds a flat array of keys (nodes), laid out breadth
+    /// first so that the subkeys of each key are adjacent; a flat array of
+    /// entries, with the values of scalar entries stored inline; a sorted table
+    /// of names; and a pool holding every name and string value once.
+    ///
+    /// Subkeys are found by binary search, through a second array which lists
+    /// each key's subkeys sorted by name and instance ID. Entries are found by
+    /// a linear scan of the key's entries, which are adjacent in memory.
+    ///
+    /// The image holds no pointers, only offsets into itself, so it can be
+    /// copied, written out, or placed in memory shared between processes as-is.
+    /// Use 'getImage' and 'attach' for that. Images use the host's byte order.
+    ///
+    /// A frozen registry can't be changed, so it can be read from any number of
+    /// threads at once without locking.
+    ///
+    class _NELOBIN_API FrozenRegistry
+    {
+    private:
+        friend class FrozenKey;
+
+    private:
+        ///
+        /// \struct Header
+        /// \brief  The start of an image. Offsets are in bytes, from the start of the image.
+        ///
+        struct Header
+        {
+            U32     m_magic;            ///< Always 'G_FROZEN_HEADER'.
+            U32     m_version;          ///< Always 'G_FROZEN_VERSION'.
+            U32     m_size;             ///< The size of the image, in bytes.
+            U32     m_nodeCount;        ///< The number of keys, including the root key.
+            U32     m_nodeOffset;
+            U32     m_entryCount;       ///< The number of entries.
+            U32     m_entryOffset;
+            U32     m_orderOffset;      ///< The sorted subkey array holds one index per key.
+            U32     m_nameCount;        ///< The number of distinct names.
+            U32     m_nameOffset;
+            U32     m_poolSize;         ///< The size of the string pool, in bytes.
+            U32     m_poolOffset;
+        };
+
+        ///
+        /// \struct Node
+        /// \brief  A key in an image.
+        ///
+        struct Node
+        {
+            U32     m_name;             ///< The key's index into the name table.
+            U32     m_instance;         ///< The key's instance ID.
+            U32     m_firstEntry;       ///< The index of the key's first entry.
+            U32     m_entryCount;       ///< The number of entries in the key.
+            U32     m_firstChild;       ///< The index of the key's first subkey.
+            U32     m_childCount;       ///< The number of subkeys in the key.
+        };
+
+        ///
+        /// \struct Record
+        /// \brief  An entry in an image.
+        ///
+        /// Scalar values are stored as 32-bit patterns in 'm_value'. Strings are
+        /// stored in the pool; 'm_value' then holds their offset into the pool.
+        ///
+        struct Record
+        {
+            U32     m_name;             ///< The entry's index into the name table.
+            U32     m_alias;            ///< The entry's type alias.
+            U32     m_value;            ///< The entry's value, or the offset of its string.
+            U32     m_length;           ///< The length of the entry's string.
+        };
+
+        ///
+        /// \struct Name
+        /// \brief  A name in an image. Names are null-terminated in the pool.
+        ///
+        struct Name
+        {
+            U32     m_offset;           ///< The name's offset into the pool.
+            U32     m_length;           ///< The name's length.
+        };
+
+    private:
+        std::vector<U32>    m_storage;      ///< Holds the image, if this registry owns it.
+        const char*         mp_image;       ///< The start of the image.
+        const Header*       mp_header;      ///< The image's header.
+        const Node*         mp_nodes;       ///< The image's key array.
+        const Record*       mp_entries;     ///< The image's entry array.
+        const U32*          mp_order;       ///< The image's sorted subkey array.
+        const Name*         mp_names;       ///< The image's name table.
+        const char*         mp_pool;        ///< The image's string pool.
+
+    private:
+        ///
+        /// \fn     bind
+        /// \brief  Checks the image at the given address, then points the array pointers into it.
+        ///
+        /// \return A status code.
+        ///
+        Status bind (const void* ap_image,
+                     const Size a_size);
+
+        ///
+        /// \fn     findName
+        /// \brief  Looks up a name in the name table.
+        ///
+        /// \param  a_name      The name to look for.
+        /// \param  a_index     Filled with the name's index, if it is found.
+        ///
+        /// \return True if the name was found.
+        ///
+        Boolean findName (const String& a_name,
+                          U32& a_index) const;
+
+    public:
+        ///
+        /// \brief  The default constructor. Constructs an empty registry.
+        ///
+        FrozenRegistry ();
+
+        ///
+        /// \brief  Constructs a frozen copy of the given key, and everything beneath it.
+        ///
+        /// \param  a_root      The key to freeze, usually a registry.
+        ///
+        explicit FrozenRegistry (const Key& a_root);
+
+        FrozenRegistry (FrozenRegistry&& a_other);
+        FrozenRegistry& operator= (FrozenRegistry&& a_other);
+
+        FrozenRegistry (const FrozenRegistry&) = delete;
+        FrozenRegistry& operator= (const FrozenRegistry&) = delete;
+
+    public:
+        ///
+        /// \fn     freeze
+        /// \brief  Replaces this registry with a frozen copy of the given key.
+        ///
+        /// Images are limited to 4 GiB. If the key is too large for that, this
+        /// registry is left empty.
+        ///
+        /// \param  a_root      The key to freeze, usually a registry.
+        ///
+        /// \return A status code.
+        ///
+        Status freeze (const Key& a_root);
+
+        ///
+        /// \fn     loadFromFile
+        /// \brief  Loads the given registry file, then freezes it.
+        ///
+        /// \param  a_filename      The name of the file to load.
+        ///
+        /// \return A status code.
+        ///
+        Status loadFromFile (const String& a_filename);
+
+        ///
+        /// \fn     attach
+        /// \brief  Uses the image at the given address, without copying it.
+        ///
+        /// The image is checked before it is used. It must stay in place, and
+        /// unchanged, for as long as this registry uses it. Its address must be
+        /// aligned to four bytes. A registry can't attach to its own image; move
+        /// it into another registry first.
+        ///
+        /// \param  ap_image    The start of the image.
+        /// \param  a_size      The size of the image, in bytes.
+        ///
+        /// \return A status code.
+        ///
+        Status attach (const void* ap_image,
+                       const Size a_size);
+
+        ///
+        /// \fn     getRoot
+        /// \brief  Gets the registry's root key.
+        ///
+        /// \return The root key, or the "null" key if the registry is empty.
+        ///
+        FrozenKey getRoot () const;
+
+    public:
+        inline const void* getImage () const { return mp_image; }
+        inline Size getImageSize () const { return (mp_header != nullptr) ? mp_header->m_size : 0; }
+        inline Boolean isEmpty () const { return mp_header == nullptr; }
+
+    };
+
+    template <typename T>
+    inline T FrozenKey::readEntry (const U32 a_entry) const
+    {
+        const FrozenRegistry::Record& l_record = mp_registry->mp_entries[a_entry];
+
+        if constexpr (std::is_same<T, String>::value == true)
+            return String { mp_registry->mp_pool + l_record.m_value, l_record.m_length };
+        else if constexpr (std::is_same<T, Float>::value == true)
+        {
+            Float l_value = 0.0f;
+            std::memcpy(&l_value, &l_record.m_value, sizeof(l_value));
+            return l_value;
+        }
+        else
+            return static_cast<T>(l_record.m_value);
+    }
+
+}
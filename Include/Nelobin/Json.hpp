@@ -0,0 +1,84 @@
+///
+/// \file   Json.hpp
+/// \brief  Converts registries to and from JSON, as streams.
+///
+
+#pragma once
+
+#include <iosfwd>
+#include <Nelobin/Registry.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \fn     writeJson
+    /// \brief  Writes a key, and everything beneath it, as a JSON object.
+    ///
+    /// Each entry becomes a member whose name is annotated with the entry's type,
+    /// after an at sign, so that its type survives the trip through JSON. Each
+    /// subkey becomes a member holding an object. Subkeys which share a name and
+    /// sit next to one another, such as the instances of a list, become a single
+    /// member holding an array of objects:
+    /// \code
+    /// {
+    ///     "Gravity@Float": 9.81,
+    ///     "Developer": {
+    ///         "Name@String": "Dennis"
+    ///     },
+    ///     "Row": [
+    ///         { "Id@U32": 1 },
+    ///         { "Id@U32": 2 }
+    ///     ]
+    /// }
+    /// \endcode
+    ///
+    /// The types are "S8", "S16", "S32", "U8", "U16", "U32", "Float" and "String".
+    /// Floats are written in the shortest form which reads back as the same value,
+    /// or as the strings "NaN", "Infinity" and "-Infinity". Strings which aren't
+    /// valid UTF-8 are written as hexadecimal, with the type "Bytes".
+    ///
+    /// Entries are written before subkeys, and every entry and subkey is written
+    /// in order, so reading the JSON back gives a registry which saves to the very
+    /// same file. To keep that order, a name is written more than once in the same
+    /// object if its instances are interleaved with other subkeys.
+    ///
+    /// The JSON is gathered into one reused chunk, and written out whenever the
+    /// chunk fills.
+    ///
+    /// \param  a_key           The key to write.
+    /// \param  a_stream        The stream to write to.
+    /// \param  a_pretty        Optional. Should the JSON be indented, one member per line?
+    ///
+    /// \return 'Status::OK', or 'Status::FileSaveError' if the stream fails.
+    ///
+    _NELOBIN_API Status writeJson (const Key& a_key,
+                                   std::ostream& a_stream,
+                                   const Boolean a_pretty = true);
+
+    ///
+    /// \fn     readJson
+    /// \brief  Reads a registry from a JSON object, as written by 'writeJson'.
+    ///
+    /// The JSON is parsed in a single pass as it is read from the stream, straight
+    /// into the registry, so only a chunk of the document is held in memory at a
+    /// time. Members holding numbers or strings must have type-annotated names.
+    /// Nesting deeper than 'G_MAX_KEY_DEPTH' is rejected. Every member
+    /// name read is interned for the life of the process; see 'Atom'.
+    ///
+    /// As with the registry's other loading methods, the caller must hold the
+    /// write lock if other threads use the registry. If parsing fails, whatever
+    /// was read before the error is kept.
+    ///
+    /// \param  a_registry      The registry to read into.
+    /// \param  a_stream        The stream to read from.
+    /// \param  a_append        Optional. Should the contents be added to those already in the registry?
+    ///
+    /// \return 'Status::OK', or 'Status::FileParseError' if the JSON is malformed.
+    ///
+    _NELOBIN_API Status readJson (Registry& a_registry,
+                                  std::istream& a_stream,
+                                  const Boolean a_append = false);
+
+}
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <unordered_map>
 #include <Nelobin/Buffer.hpp>
+#include <Nelobin/Counters.hpp>
 #include <Nelobin/Entry.hpp>
 #include <Nelobin/Error.hpp>
 #include <Nelobin/Export.hpp>
@@ -13,6 +16,43 @@
 namespace Nelobin
 {
 
+    ///
+    /// \struct MemoryUsage
+    /// \brief  The memory taken by a key and everything beneath it.
+    ///
+    /// Byte counts are estimates, since the allocator's own bookkeeping isn't
+    /// visible, but they are comparable between keys. Names are interned into the
+    /// shared atom table, so each distinct name used beneath a key is counted once.
+    ///
+    struct MemoryUsage
+    {
+        Size    m_keys;             ///< The number of keys, the measured key included.
+        Size    m_entries;          ///< The number of entries.
+        Size    m_nodes;            ///< Bytes taken by the key and entry objects, and the pointers which own them.
+        Size    m_names;            ///< Bytes of the atom table taken by the distinct names used.
+        Size    m_strings;          ///< Bytes of string values stored outside of their entries.
+        Size    m_slack;            ///< Bytes allocated, but unused, by containers and strings.
+        Size    m_images;           ///< Bytes held by the serialized images of keys which cache them.
+        Size    m_serialized;       ///< Bytes taken in the standard layout, not counting the file header.
+
+        inline Size getTotal () const { return m_nodes + m_names + m_strings + m_slack + m_images; }
+    };
+
+    namespace Private
+    {
+        struct KeyImage;
+    }
+
+    ///
+    /// \struct PathUsage
+    /// \brief  The memory taken by the subkey at the given path.
+    ///
+    struct PathUsage
+    {
+        String          m_path;     ///< The subkey's path, as read by 'nextPathComponent'.
+        MemoryUsage     m_usage;    ///< The memory taken by the subkey.
+    };
+
     ///
     /// \class  Key
     /// \brief  A "folder" in the registry, containing entries and subkeys.
@@ -20,32 +60,70 @@ namespace Nelobin
     /// In a Nelobin Registry, a key is like a folder. It is a container that
     /// can hold registry entries - key-value pairs of data - and even other keys.
     ///
+    /// Subkeys are reference-counted, so that copies of a registry can share
+    /// them. A shared subkey is copied the first time it is reached through one
+    /// of the non-const methods below, so changes made to one copy never show up
+    /// in another. Only the keys on the path to the change are copied.
+    ///
     class _NELOBIN_API Key
     {
+    private:
+        friend class RegistryOverlay;
+        friend class FrozenRegistry;
+        friend class EntryBase;
+
     public:
-        using Ptr           = std::unique_ptr<Key>;
+        using Ptr           = std::shared_ptr<Key>;
         using Container     = std::vector<Ptr>;
         using Iterator      = Container::iterator;
         using CIterator     = Container::const_iterator;
 
     private:
         /// A "null" key, returned in case of errors retriving and adding keys.
-        static Key              s_null;
+        ///
+        /// Each thread has its own "null" key, so writes to it can't race with
+        /// other threads.
+        static thread_local Key s_null;
+
+    private:
+        ///
+        /// \fn     getNull
+        /// \brief  Gets this thread's "null" key, emptied of anything added to it.
+        ///
+        static Key& getNull ();
 
     protected:
-        String                  m_name;         ///< The non-unique name of the key.
+        Atom                    m_name;         ///< The non-unique name of the key.
         U32                     m_instance;     ///< The unique instance ID of the key.
         EntryBase::Container    m_entries;      ///< Contains the key's entries.
         Container               m_keys;         ///< Contains the registry's keys, or the key's subkeys.
         Key*                    mp_parent;      ///< A pointer to the key's parent key.
+        Size                    m_revision;     ///< In a root key, counts structural changes made anywhere beneath it.
+
+        /// The key's serialized size, as last measured, tagged with the format it
+        /// was measured in, and with whether 'mp_image' holds the key as written
+        /// in that format. Zero if it hasn't been measured since the last change.
+        /// Atomic, since it is filled in by const methods, which may run at once.
+        mutable std::atomic<U64> m_serializedSize;
+
+        /// The key as last serialized, if it caches its image. Only valid while
+        /// 'm_serializedSize' says so. Read and replaced with 'std::atomic_load'
+        /// and 'std::atomic_store', since it is filled in by 'serialize'.
+        mutable std::shared_ptr<const Private::KeyImage> mp_image;
+        Boolean                 m_imageCached;  ///< Does this key cache its serialized image?
 
     private:
         ///
         /// The methods below seek out a registry entry mapped to the
         /// given name.
         ///
+        /// The overloads taking a string probe the atom table once, then
+        /// compare atoms. A name which was never interned is never found.
+        ///
         EntryBase::Iterator seekEntry (const String& a_name);
         EntryBase::CIterator cseekEntry (const String& a_name) const;
+        EntryBase::Iterator seekEntry (const Atom& a_name);
+        EntryBase::CIterator cseekEntry (const Atom& a_name) const;
 
         ///
         /// The following methods seek out a registry key mapped to the
@@ -55,6 +133,10 @@ namespace Nelobin
                                const U32 a_instance);
         Key::CIterator cseekKey (const String& a_name,
                                  const U32 a_instance) const;
+        Key::Iterator seekKey (const Atom& a_name,
+                               const U32 a_instance);
+        Key::CIterator cseekKey (const Atom& a_name,
+                                 const U32 a_instance) const;
 
         ///
         /// And these methods seek out a registry key mapped to the given
@@ -63,20 +145,88 @@ namespace Nelobin
         /// These methods are useful for iterating through the key container
         /// to find out how many keys are present with the same name.
         ///
-        Key::Iterator seekKeyFrom (const String& a_name,
+        Key::Iterator seekKeyFrom (const Atom& a_name,
                                    Key::Iterator a_from);
-        Key::CIterator cseekKeyFrom (const String& a_name,
+        Key::CIterator cseekKeyFrom (const Atom& a_name,
                                      Key::CIterator a_from) const;
 
+        ///
+        /// \fn     detach
+        /// \brief  Makes sure that this key is the only owner of the given subkey.
+        ///
+        /// If the subkey is shared with another copy of the registry, it is replaced
+        /// with a copy of its own. Either way, the subkey's parent is set to this key.
+        /// Every non-const method which hands out or changes a subkey goes through here.
+        ///
+        /// \param  a_slot      The subkey, as held in this key's container.
+        ///
+        /// \return The subkey, now owned by this key alone.
+        ///
+        Key& detach (Key::Ptr& a_slot);
+
+        ///
+        /// The methods below support the columnar layout, in which a run of
+        /// same-named sibling keys, each holding the same entries and no subkeys,
+        /// is written as one block: a schema, then one array per entry.
+        ///
+        /// 'seekColumnRun' returns the length of the run of subkeys starting at
+        /// the given index, or 1 if those subkeys should be written one by one.
+        /// 'getColumnEncoding' chooses how a column's values are written to the
+        /// given buffer, and gets their size there if they are integers.
+        ///
+        Boolean hasSameSchema (const Key& a_other) const;
+        Size seekColumnRun (const Size a_from) const;
+        U8 getColumnEncoding (const Buffer& a_buffer,
+                              const Size a_from,
+                              const Size a_count,
+                              const Size a_column,
+                              Size* ap_size) const;
+        void serializeColumns (Buffer& a_buffer,
+                               const Size a_from,
+                               const Size a_count) const;
+        Size getColumnsSize (const Buffer& a_buffer,
+                             const Size a_from,
+                             const Size a_count) const;
+
+        ///
+        /// \fn     serializeContents
+        /// \brief  Encodes this key into the given buffer, without using its cached image.
+        ///
+        void serializeContents (Buffer& a_buffer) const;
+
     protected:
         ///
         /// The methods below are for de-serializing the next entity in a key
-        /// or registry, be it a entry or subkey.
+        /// or registry, be it a entry, subkey or block of columns.
         ///
         Boolean deserializeEntry (Buffer& a_buffer);
         Boolean deserializeKey (Buffer& a_buffer);
+        Boolean deserializeColumns (Buffer& a_buffer);
         Boolean deserializeNext (Buffer& a_buffer);
 
+        ///
+        /// \fn     collectNames
+        /// \brief  Adds the names of this key's entries and subkeys, recursively, to
+        ///         the given buffer's name table.
+        ///
+        void collectNames (Buffer& a_buffer) const;
+
+        ///
+        /// \fn     measure
+        /// \brief  Adds up the memory taken by this key and its subkeys.
+        ///
+        /// \param  a_usage     Filled with the memory taken.
+        /// \param  a_names     Filled with the IDs of the names used, mapped to the bytes each takes.
+        /// \param  a_path      The path to this key. Subkeys' paths are appended to it, then removed.
+        /// \param  ap_paths    Optional. A min-heap of the heaviest subkeys found, holding up to 'a_count'.
+        /// \param  a_count     The number of subkeys to keep in the heap.
+        ///
+        void measure (MemoryUsage& a_usage,
+                      std::unordered_map<U32, Size>& a_names,
+                      String& a_path,
+                      std::vector<PathUsage>* ap_paths,
+                      const Size a_count) const;
+
     protected:
         ///
         /// \brief  The default constructor.
@@ -93,6 +243,77 @@ namespace Nelobin
              const U32 a_instance = 0,
              Key* ap_parent = nullptr);
 
+        ///
+        /// \brief  Constructs a key with an already-interned name.
+        ///
+        /// \param  a_name      The name of the key.
+        /// \param  a_instance  The unique instance ID of the key.
+        /// \param  ap_parent   A pointer to this key's parent.
+        ///
+        Key (const Atom& a_name,
+             const U32 a_instance,
+             Key* ap_parent);
+
+        ///
+        /// \brief  Constructs a copy of the given key, which shares its subkeys.
+        ///
+        /// The key's entries are copied, and its subkeys are shared.
+        ///
+        /// \param  a_other     The key to copy.
+        /// \param  ap_parent   A pointer to the copy's parent.
+        ///
+        Key (const Key& a_other,
+             Key* ap_parent);
+
+        ///
+        /// \fn     shareContents
+        /// \brief  Replaces this key's contents with copies of the given key's entries,
+        ///         and references to its subkeys.
+        ///
+        void shareContents (const Key& a_other);
+
+        ///
+        /// \fn     markChanged
+        /// \brief  Records a structural change to this key.
+        ///
+        /// Adding, renaming or removing an entry or subkey, or copying a shared
+        /// subkey, bumps the revision of the root key, so that anything caching
+        /// pointers into the registry knows to drop them.
+        ///
+        void markChanged ();
+
+        ///
+        /// \fn     markDirty
+        /// \brief  Records a change to one of this key's entries.
+        ///
+        /// The serialized sizes and images cached by this key and its parents are
+        /// dropped.
+        ///
+        void markDirty ();
+
+        ///
+        /// \fn     takeContents
+        /// \brief  Swaps this key's entries and subkeys with those of the given key.
+        ///
+        /// The subkeys taken are re-parented to this key. Subkeys given back are
+        /// only re-parented if nothing else shares them.
+        ///
+        void takeContents (Key& a_other);
+
+        ///
+        /// \fn     appendContents
+        /// \brief  Moves the given key's entries and subkeys into this key, as if they
+        ///         had been loaded into it.
+        ///
+        /// Entries replace the values of existing entries of the same name and type,
+        /// and subkeys are added after this key's own, with their instance IDs
+        /// numbered on from them. Entries and subkeys already in this key are left
+        /// where they are, so handles to them stay valid.
+        ///
+        /// \param  a_other     The key to take from. Its subkeys must not be shared.
+        ///
+        void appendContents (Key& a_other);
+
     public:
         ///
         /// \brief  The destructor.
@@ -114,29 +335,34 @@ namespace Nelobin
         template <typename T>
         inline Entry<T>& getEntry (const String& a_name)
         {
+            _Nelobin_Count(EntryLookups, 1);
+
             // Check to see if the user specified a name.
             if (a_name.empty() == true)
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): You need to specify a name for the entry.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Find the entry.
             auto l_find = seekEntry(a_name);
             if (l_find == m_entries.end())
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): Entry, \"" << a_name << "\", not found.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Check to see if the type of the entry found and the type expected match.
             if ((*l_find)->getAlias() != TT_Type<T>::Alias)
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): Entry, \"" << a_name << "\", was found, but a type mismatch occured.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Downcast and return the pointer.
@@ -153,29 +379,34 @@ namespace Nelobin
         template <typename T>
         inline const Entry<T>& getEntry (const String& a_name) const
         {
+            _Nelobin_Count(EntryLookups, 1);
+
             // Check to see if the user specified a name.
             if (a_name.empty() == true)
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): You need to specify a name for the entry.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Find the entry.
             auto l_find = cseekEntry(a_name);
             if (l_find == m_entries.cend())
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): Entry, \"" << a_name << "\", not found.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Check to see if the type of the entry found and the type expected match.
             if ((*l_find)->getAlias() != TT_Type<T>::Alias)
             {
-                _Nelobin_Error("Key::getEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntry(): Entry, \"" << a_name << "\", was found, but a type mismatch occured.");
-                return Entry<T>::s_null;
+                _Nelobin_Count(EntryMisses, 1);
+                return Entry<T>::getNull();
             }
 
             // Downcast and return the pointer.
@@ -183,6 +414,145 @@ namespace Nelobin
             return *lp_downcast;
         }
 
+        ///
+        /// \fn     tryGetEntry
+        /// \brief  Gets the data entry with the given name, if it exists.
+        ///
+        /// Unlike 'getEntry', this method reports nothing if the entry is missing
+        /// or of another type, so it is suited to probing for optional entries.
+        ///
+        /// \param  a_name      The name of the entry.
+        ///
+        /// \return The entry in question, or null if it is missing or mistyped.
+        ///
+        template <typename T>
+        inline Entry<T>* tryGetEntry (const String& a_name)
+        {
+            _Nelobin_Count(EntryLookups, 1);
+
+            auto l_find = seekEntry(a_name);
+            if (l_find == m_entries.end() || (*l_find)->getAlias() != TT_Type<T>::Alias)
+            {
+                _Nelobin_Count(EntryMisses, 1);
+                return nullptr;
+            }
+
+            return static_cast<Entry<T>*>((*l_find).get());
+        }
+
+        template <typename T>
+        inline const Entry<T>* tryGetEntry (const String& a_name) const
+        {
+            _Nelobin_Count(EntryLookups, 1);
+
+            auto l_find = cseekEntry(a_name);
+            if (l_find == m_entries.cend() || (*l_find)->getAlias() != TT_Type<T>::Alias)
+            {
+                _Nelobin_Count(EntryMisses, 1);
+                return nullptr;
+            }
+
+            return static_cast<const Entry<T>*>((*l_find).get());
+        }
+
+        ///
+        /// \fn     getOr
+        /// \brief  Gets the value of the data entry with the given name, or a fallback value.
+        ///
+        /// Like 'tryGetEntry', this method reports nothing if the entry is missing
+        /// or of another type.
+        ///
+        /// \param  a_name      The name of the entry.
+        /// \param  a_default   The value to return if the entry is missing or mistyped.
+        ///
+        /// \return The entry's value, or the fallback value.
+        ///
+        template <typename T>
+        inline T getOr (const String& a_name,
+                        const T& a_default) const
+        {
+            const Entry<T>* lp_entry = tryGetEntry<T>(a_name);
+            return (lp_entry != nullptr) ? lp_entry->get() : a_default;
+        }
+
+        ///
+        /// \fn     gatherColumn
+        /// \brief  Gathers the value of one entry from every instance of a subkey.
+        ///
+        /// This method makes one pass over this key's subkeys. For the i-th subkey
+        /// named 'a_keyName' (the subkey with instance ID i), the value of its entry
+        /// named 'a_entryName' is written to 'ap_out[i]'. If that subkey has no such
+        /// entry, or the entry is of another type, 'ap_out[i]' is set to a default
+        /// value and bit i of the 'ap_missing' bitmap is set. Nothing is reported to
+        /// the error stream.
+        ///
+        /// Values are only written for the first 'a_capacity' instances. The number
+        /// of instances found is always returned, so the method can be called with
+        /// no output first, to size the output array.
+        ///
+        /// \param  a_keyName       The name of the subkeys to gather from.
+        /// \param  a_entryName     The name of the entry to gather.
+        /// \param  ap_out          Filled with the values gathered. Holds 'a_capacity' values.
+        /// \param  a_capacity      The number of values 'ap_out' can hold.
+        /// \param  ap_missing      Optional. A bitmap of at least '(a_capacity + 7) / 8' bytes,
+        ///                         in which bit i is set if value i is missing or mistyped,
+        ///                         and cleared otherwise.
+        ///
+        /// \return The number of subkeys named 'a_keyName'.
+        ///
+        template <typename T>
+        inline Size gatherColumn (const String& a_keyName,
+                                  const String& a_entryName,
+                                  T* ap_out,
+                                  const Size a_capacity,
+                                  U8* ap_missing = nullptr) const
+        {
+            // Names which were never interned can't be found anywhere.
+            Atom l_keyName, l_entryName;
+            if (Atom::probe(a_keyName, l_keyName) == false)
+                return 0;
+
+            const Boolean l_entryKnown = Atom::probe(a_entryName, l_entryName);
+
+            Size l_row = 0;
+            for (const auto& l_key : m_keys)
+            {
+                if (l_key->m_name != l_keyName)
+                    continue;
+
+                if (l_row < a_capacity)
+                {
+                    const EntryBase* lp_entry = nullptr;
+                    if (l_entryKnown == true)
+                    {
+                        auto l_find = l_key->cseekEntry(l_entryName);
+                        if (l_find != l_key->m_entries.cend() &&
+                            (*l_find)->getAlias() == TT_Type<T>::Alias)
+                            lp_entry = l_find->get();
+                    }
+
+                    // The alias has been checked, so there's no need for a dynamic cast.
+                    const U8 l_bit = static_cast<U8>(1u << (l_row & 7));
+                    if (lp_entry != nullptr)
+                    {
+                        ap_out[l_row] = static_cast<const Entry<T>*>(lp_entry)->get();
+                        if (ap_missing != nullptr)
+                            ap_missing[l_row >> 3] &= static_cast<U8>(~l_bit);
+                    }
+                    else
+                    {
+                        ap_out[l_row] = T();
+                        if (ap_missing != nullptr)
+                            ap_missing[l_row >> 3] |= l_bit;
+                    }
+                }
+
+                l_row++;
+            }
+
+            return l_row;
+        }
+
         ///
         /// \fn     getEntryBaseAt
         /// \brief  Gets the entry base located at the given index.
@@ -200,7 +570,19 @@ namespace Nelobin
             // Check to see if the index is in bounds.
             if (a_index >= m_entries.size())
             {
-                _Nelobin_Error("Key::getEntryAt(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::getEntryAt(): In key \"" << getName() << "\":");
+                _Nelobin_Error("Key::getEntryAt(): Index " << a_index << " is out of range.");
+                return EntryBase::s_null;
+            }
+
+            return *m_entries[a_index];
+        }
+
+        inline const EntryBase& getEntryBaseAt (const Size a_index) const
+        {
+            if (a_index >= m_entries.size())
+            {
+                _Nelobin_Error("Key::getEntryAt(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::getEntryAt(): Index " << a_index << " is out of range.");
                 return EntryBase::s_null;
             }
@@ -221,7 +603,7 @@ namespace Nelobin
             // Check to see if the user specified a name.
             if (a_name.empty() == true)
             {
-                _Nelobin_Error("Key::stringifyEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::stringifyEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::stringifyEntry(): You need to specify a name for the entry.");
                 return "";
             }
@@ -230,7 +612,7 @@ namespace Nelobin
             auto l_find = seekEntry(a_name);
             if (l_find == m_entries.end())
             {
-                _Nelobin_Error("Key::stringifyEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::stringifyEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::stringifyEntry(): Entry, \"" << a_name << "\", not found.");
                 return "";
             }
@@ -252,7 +634,7 @@ namespace Nelobin
             // Check to see if the index is in bounds.
             if (a_index >= m_entries.size())
             {
-                _Nelobin_Error("Key::stringifyEntryAt(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::stringifyEntryAt(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::stringifyEntryAt(): Index " << a_index << " is out of range.");
                 return "";
             }
@@ -274,9 +656,31 @@ namespace Nelobin
             // Early out if no name is specified.
             if (a_name.empty() == true)
             {
-                _Nelobin_Error("Key::addEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::addEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::addEntry(): You need to specify a name for the new entry.");
-                return Entry<T>::s_null;
+                return Entry<T>::getNull();
+            }
+
+            return addEntry<T>(Atom::intern(a_name));
+        }
+
+        ///
+        /// \fn     addEntry
+        /// \brief  Adds a new entry to the key with the given, already-interned, name.
+        ///
+        /// \param  a_name      The new entry's name.
+        ///
+        /// \return A handle to the newly-created (or already-existing) entry.
+        ///
+        template <typename T>
+        inline Entry<T>& addEntry (const Atom& a_name)
+        {
+            // Early out if no name is specified.
+            if (a_name.isEmpty() == true)
+            {
+                _Nelobin_Error("Key::addEntry(): In key \"" << getName() << "\":");
+                _Nelobin_Error("Key::addEntry(): You need to specify a name for the new entry.");
+                return Entry<T>::getNull();
             }
 
             // Check to see if the entry already exists in the type specified.
@@ -287,9 +691,9 @@ namespace Nelobin
                 // entry found.
                 if ((*l_find)->getAlias() != TT_Type<T>::Alias)
                 {
-                    _Nelobin_Error("Key::addEntry(): In key \"" << m_name << "\":");
-                    _Nelobin_Error("Key::addEntry(): Entry \"" << a_name << "\" was found, but a type mismatch occured.");
-                    return Entry<T>::s_null;
+                    _Nelobin_Error("Key::addEntry(): In key \"" << getName() << "\":");
+                    _Nelobin_Error("Key::addEntry(): Entry \"" << a_name.getString() << "\" was found, but a type mismatch occured.");
+                    return Entry<T>::getNull();
                 }
                 else
                 {
@@ -300,8 +704,10 @@ namespace Nelobin
 
             // Add, downcast, and return the new entry.
             EntryBase* lp_new = new Entry<T>(a_name);
+            lp_new->mp_owner = this;
             EntryBase::Ptr l_wrap { lp_new };
             m_entries.push_back(std::move(l_wrap));
+            markChanged();
 
             Entry<T>* lp_downcast = dynamic_cast<Entry<T>*>(lp_new);
             return *lp_downcast;
@@ -320,7 +726,7 @@ namespace Nelobin
             // Check to see if the user provided the name of the existing key.
             if (a_name.empty() == true)
             {
-                _Nelobin_Error("Key::renameEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::renameEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::renameEntry(): You need to specify an entry to rename.");
                 return;
             }
@@ -328,7 +734,7 @@ namespace Nelobin
             // Check to see if the user provided a new name for the entry in question.
             if (a_newName.empty() == true)
             {
-                _Nelobin_Error("Key::renameEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::renameEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::renameEntry(): You need to specify a new name for the entry.");
                 return;
             }
@@ -336,7 +742,7 @@ namespace Nelobin
             // Check to see if the new name is valid.
             if (a_newName == "root" || a_newName == "null")
             {
-                _Nelobin_Error("Key::renameEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::renameEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::renameEntry(): The new name, \"" << a_newName << "\", is reserved.");
                 return;
             }
@@ -344,7 +750,7 @@ namespace Nelobin
             // Check to see if the new name is already used.
             if (cseekEntry(a_newName) != m_entries.end())
             {
-                _Nelobin_Error("Key::renameEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::renameEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::renameEntry(): The new name, \"" << a_newName << "\", is already used.");
                 return;
             }
@@ -353,13 +759,14 @@ namespace Nelobin
             auto l_find = seekEntry(a_name);
             if (l_find == m_entries.end())
             {
-                _Nelobin_Error("Key::renameEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::renameEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::renameEntry(): Entry, \"" << a_name << "\", not found.");
                 return;
             }
 
             // Now rename the entry.
-            (*l_find)->m_name = a_newName;
+            (*l_find)->m_name = Atom::intern(a_newName);
+            markChanged();
         }
 
         ///
@@ -374,13 +781,14 @@ namespace Nelobin
             auto l_find = seekEntry(a_name);
             if (l_find == m_entries.end())
             {
-                _Nelobin_Error("Key::removeEntry(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::removeEntry(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::removeEntry(): Entry \"" << a_name << "\" not found.");
                 return;
             }
 
             // Now remove it.
             l_find = m_entries.erase(l_find);
+            markChanged();
         }
 
     public:
@@ -390,7 +798,48 @@ namespace Nelobin
         ///
         /// \param  a_buffer    The byte buffer to serialize to.
         ///
-        void serialize (Buffer& a_buffer);
+        void serialize (Buffer& a_buffer) const;
+
+        ///
+        /// \fn     setImageCached
+        /// \brief  Sets whether this key keeps a copy of its bytes, as last serialized.
+        ///
+        /// A key which caches its image writes it out verbatim when it is next
+        /// serialized in the same format, as long as neither it nor anything beneath
+        /// it has changed since. Changes drop the images cached on the path from the
+        /// changed key up to the root, so a save after a small change re-encodes only
+        /// that path, and copies every other cached subtree as it is.
+        ///
+        /// Each image holds the whole subtree beneath its key, so cache images on the
+        /// keys of large, mostly-unchanging subtrees, rather than on every key. Images
+        /// aren't used with name tables, since a key's bytes then depend on the table.
+        ///
+        /// \param  a_cached    Should the key cache its image? Turning this off drops the image.
+        ///
+        void setImageCached (const Boolean a_cached);
+
+        ///
+        /// \fn     isImageCached
+        /// \brief  Checks to see if this key keeps a copy of its bytes, as last serialized.
+        ///
+        Boolean isImageCached () const;
+
+        ///
+        /// \fn     getSerializedSize
+        /// \brief  Gets the number of bytes 'serialize' writes to the given buffer.
+        ///
+        /// The size is measured in the buffer's format, without writing anything.
+        /// Each key caches its size until it, or anything beneath it, changes, so
+        /// measuring a registry again after a small change re-measures only the
+        /// keys on the path to that change. Sizes measured with a name table depend
+        /// on the whole table, so they aren't cached.
+        ///
+        /// \param  a_buffer    The buffer which the key would be serialized into. If it
+        ///                     uses a name table, the table must be filled in already.
+        ///
+        /// \return The key's serialized size, in bytes.
+        ///
+        Size getSerializedSize (const Buffer& a_buffer) const;
 
         ///
         /// \fn     getInstanceCount
@@ -404,6 +853,7 @@ namespace Nelobin
         /// \return The number of keys found.
         ///
         U32 getInstanceCount (const String& a_name);
+        U32 getInstanceCount (const Atom& a_name);
 
         ///
         /// \fn     rename
@@ -427,6 +877,22 @@ namespace Nelobin
         const Key& getKey (const String& a_name,
                            const U32 a_instance = 0) const;
 
+        ///
+        /// \fn     tryGetKey
+        /// \brief  Retrieves the key with the given name and instance ID, if it exists.
+        ///
+        /// Unlike 'getKey', this method reports nothing if the key is missing.
+        ///
+        /// \param  a_name      The name of the key.
+        /// \param  a_instance  Optional. The key's instance ID.
+        ///
+        /// \return The key found, or null.
+        ///
+        Key* tryGetKey (const String& a_name,
+                        const U32 a_instance = 0);
+        const Key* tryGetKey (const String& a_name,
+                              const U32 a_instance = 0) const;
+
         ///
         /// \fn     getKey
         /// \brief  Retrieves the key located at the given index.
@@ -448,6 +914,29 @@ namespace Nelobin
         ///
         Key& addKey (const String& a_name);
 
+        ///
+        /// \fn     addKey
+        /// \brief  Adds a new key with the given, already-interned, name.
+        ///
+        /// \param  a_name      The name of the new key.
+        ///
+        /// \return The newly added key.
+        ///
+        Key& addKey (const Atom& a_name);
+
+        ///
+        /// \fn     addCopy
+        /// \brief  Adds a copy of the given key as a new subkey.
+        ///
+        /// The copy bears the given key's name. It shares the given key's subkeys,
+        /// so only the given key's own entries are actually copied.
+        ///
+        /// \param  a_key       The key to copy.
+        ///
+        /// \return The newly added copy.
+        ///
+        Key& addCopy (const Key& a_key);
+
         ///
         /// \fn     removeKey
         /// \brief  Removes the key with the given name and instance ID.
@@ -464,13 +953,39 @@ namespace Nelobin
         ///
         void clear ();
 
+        ///
+        /// \fn     getMemoryUsage
+        /// \brief  Measures the memory taken by this key and everything beneath it.
+        ///
+        /// Shared subkeys, left by copying a registry, are counted in full by every
+        /// registry sharing them.
+        ///
+        /// \return The memory taken, broken down by what it holds.
+        ///
+        MemoryUsage getMemoryUsage () const;
+
+        ///
+        /// \fn     getHeaviestPaths
+        /// \brief  Finds the subkeys, at any depth, taking the most memory.
+        ///
+        /// Each subkey is measured along with everything beneath it, so the parents
+        /// of a heavy subkey are at least as heavy, and are listed too.
+        ///
+        /// \param  a_count     The number of subkeys to list.
+        ///
+        /// \return The heaviest subkeys, heaviest first.
+        ///
+        std::vector<PathUsage> getHeaviestPaths (const Size a_count) const;
+
     public:
         const String& getName () const;
+        const Atom& getAtom () const;
         U32 getInstanceID () const;
         Size getEntryCount () const;
         Size getKeyCount () const;
         Boolean isNull () const;
         Boolean isParent () const;
+        Size getRevision () const;
         Key& getParent ();
 
     };
@@ -0,0 +1,110 @@
+///
+/// \file   MappedFile.hpp
+/// \brief  Maps a file, or a shared memory segment, into memory.
+///
+
+#pragma once
+
+#include <Nelobin/Types.hpp>
+#include <Nelobin/Error.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  MappedFile
+    /// \brief  Maps a file, or a shared memory segment, into memory.
+    ///
+    /// The mapping is released when the object is destroyed, or closed. Memory
+    /// mapping is only supported on POSIX systems; elsewhere, opening always
+    /// fails with 'Status::FileLoadError'.
+    ///
+    class _NELOBIN_API MappedFile
+    {
+    private:
+        char*       mp_data;        ///< The start of the mapping.
+        Size        m_size;         ///< The size of the mapping, in bytes.
+        Boolean     m_writable;     ///< Can the mapping be written to?
+
+    private:
+        ///
+        /// \fn     map
+        /// \brief  Maps the whole of the given file descriptor, then closes it.
+        ///
+        Status map (const int a_descriptor,
+                    const Boolean a_writable);
+
+    public:
+        ///
+        /// \brief  The default constructor. Maps nothing.
+        ///
+        MappedFile ();
+
+        ///
+        /// \brief  The destructor. Releases the mapping.
+        ///
+        ~MappedFile ();
+
+        MappedFile (MappedFile&& a_other);
+        MappedFile& operator= (MappedFile&& a_other);
+
+        MappedFile (const MappedFile&) = delete;
+        MappedFile& operator= (const MappedFile&) = delete;
+
+    public:
+        ///
+        /// \fn     open
+        /// \brief  Maps the given file.
+        ///
+        /// If the mapping is writable, changes made through it are written back
+        /// to the file, and seen by every other process mapping the same file.
+        ///
+        /// \param  a_filename      The name of the file to map.
+        /// \param  a_writable      Optional. Should the mapping be writable?
+        ///
+        /// \return A status code.
+        ///
+        Status open (const String& a_filename,
+                     const Boolean a_writable = false);
+
+        ///
+        /// \fn     openSharedMemory
+        /// \brief  Maps the given POSIX shared memory segment, read-only.
+        ///
+        /// \param  a_name      The segment's name, such as "/nelobin-config".
+        ///
+        /// \return A status code.
+        ///
+        Status openSharedMemory (const String& a_name);
+
+        ///
+        /// \fn     sync
+        /// \brief  Writes changes made to the given range of a writable mapping back to its file.
+        ///
+        /// This method blocks until the changes have been written.
+        ///
+        /// \param  a_offset    The offset of the first byte changed.
+        /// \param  a_length    The number of bytes changed.
+        ///
+        /// \return A status code.
+        ///
+        Status sync (const Size a_offset,
+                     const Size a_length);
+
+        ///
+        /// \fn     close
+        /// \brief  Releases the mapping.
+        ///
+        void close ();
+
+    public:
+        inline char* getData () { return mp_data; }
+        inline const char* getData () const { return mp_data; }
+        inline Size getSize () const { return m_size; }
+        inline Boolean isOpen () const { return mp_data != nullptr; }
+        inline Boolean isWritable () const { return m_writable; }
+
+    };
+
+}
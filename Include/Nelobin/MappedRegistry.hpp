@@ -0,0 +1,120 @@
+///
+/// \file   MappedRegistry.hpp
+/// \brief  Shares one frozen registry between processes, through a file or shared memory.
+///
+
+#pragma once
+
+#include <Nelobin/FrozenRegistry.hpp>
+#include <Nelobin/MappedFile.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  MappedRegistry
+    /// \brief  Shares one frozen registry between processes, through a file or shared memory.
+    ///
+    /// One process freezes a registry, and writes its image into a file or a
+    /// POSIX shared memory segment. Any number of processes then map the image
+    /// read-only, and query it in place: nothing is parsed or copied, and every
+    /// process shares the same physical memory.
+    ///
+    /// Writing an image never changes one which is already mapped. The image is
+    /// written to a new file, which then replaces the old one, or to a new shared
+    /// memory segment, which then takes the old one's name. Processes which have
+    /// mapped the old image keep it until they close it.
+    ///
+    /// A mapped registry can be read from any number of threads at once.
+    ///
+    class _NELOBIN_API MappedRegistry
+    {
+    private:
+        MappedFile          m_file;         ///< The mapped image.
+        FrozenRegistry      m_registry;     ///< Reads the mapped image in place.
+
+    public:
+        ///
+        /// \fn     writeFile
+        /// \brief  Writes the given registry's image to a file.
+        ///
+        /// The image is written to a uniquely named file in the same directory,
+        /// which is then renamed over the given one, so any number of processes
+        /// may write the same file at once. Like mapping, this is only supported
+        /// on POSIX systems.
+        ///
+        /// \param  a_filename      The name of the file.
+        /// \param  a_registry      The registry to write.
+        ///
+        /// \return A status code. An empty registry, holding no image, is not written.
+        ///
+        static Status writeFile (const String& a_filename,
+                                 const FrozenRegistry& a_registry);
+
+        ///
+        /// \fn     writeSharedMemory
+        /// \brief  Writes the given registry's image to a POSIX shared memory segment.
+        ///
+        /// \param  a_name          The segment's name, such as "/nelobin-config".
+        /// \param  a_registry      The registry to write.
+        ///
+        /// \return A status code. An empty registry, holding no image, is not written.
+        ///
+        static Status writeSharedMemory (const String& a_name,
+                                         const FrozenRegistry& a_registry);
+
+        ///
+        /// \fn     removeSharedMemory
+        /// \brief  Removes the name of a POSIX shared memory segment.
+        ///
+        /// The segment itself lives on until every process mapping it closes it.
+        ///
+        /// \param  a_name          The segment's name.
+        ///
+        static void removeSharedMemory (const String& a_name);
+
+    public:
+        ///
+        /// \brief  The default constructor. Maps nothing.
+        ///
+        MappedRegistry ();
+
+        MappedRegistry (const MappedRegistry&) = delete;
+        MappedRegistry& operator= (const MappedRegistry&) = delete;
+
+    public:
+        ///
+        /// \fn     openFile
+        /// \brief  Maps the registry image in the given file.
+        ///
+        /// \param  a_filename      The name of the file.
+        ///
+        /// \return A status code.
+        ///
+        Status openFile (const String& a_filename);
+
+        ///
+        /// \fn     openSharedMemory
+        /// \brief  Maps the registry image in the given POSIX shared memory segment.
+        ///
+        /// \param  a_name          The segment's name.
+        ///
+        /// \return A status code.
+        ///
+        Status openSharedMemory (const String& a_name);
+
+        ///
+        /// \fn     close
+        /// \brief  Releases the mapped image. Keys taken from it may no longer be used.
+        ///
+        void close ();
+
+    public:
+        inline FrozenKey getRoot () const { return m_registry.getRoot(); }
+        inline const FrozenRegistry& getRegistry () const { return m_registry; }
+        inline Boolean isOpen () const { return m_file.isOpen(); }
+
+    };
+
+}
@@ -51,4 +51,32 @@ namespace Nelobin
     ///
     _NELOBIN_API Float decodeFloat (const U32 a_integer);
 
+    ///
+    /// \fn     encodeZigzag
+    /// \brief  Maps a signed integer onto an unsigned one, so that values of small
+    ///         magnitude, positive or negative, become small unsigned values.
+    ///
+    /// \param  a_integer           The integer to be encoded.
+    ///
+    /// \return The encoded integer.
+    ///
+    inline U32 encodeZigzag (const S32 a_integer)
+    {
+        return (static_cast<U32>(a_integer) << 1) ^
+               static_cast<U32>(a_integer >> 31);
+    }
+
+    ///
+    /// \fn     decodeZigzag
+    /// \brief  Reverses the mapping made by 'encodeZigzag'.
+    ///
+    /// \param  a_integer           The integer to be decoded.
+    ///
+    /// \return The decoded integer.
+    ///
+    inline S32 decodeZigzag (const U32 a_integer)
+    {
+        return static_cast<S32>((a_integer >> 1) ^ (~(a_integer & 1) + 1));
+    }
+
 }
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <Nelobin/Key.hpp>
 #include <Nelobin/Export.hpp>
 
@@ -17,8 +20,21 @@ namespace Nelobin
     ///
     /// This collection can be saved to and loaded from a file.
     ///
+    /// A registry can be shared between threads. Any number of threads may read
+    /// from it at once, through its const methods and the const methods of its
+    /// keys and entries, as long as they hold a read lock. Anything which changes
+    /// the registry, including loading it, must hold the write lock. The 'read'
+    /// and 'write' methods run a function while holding the appropriate lock.
+    ///
     class _NELOBIN_API Registry : public Key
     {
+    public:
+        using ReadLock      = std::shared_lock<std::shared_mutex>;
+        using WriteLock     = std::unique_lock<std::shared_mutex>;
+
+    private:
+        mutable std::shared_mutex   m_mutex;    ///< Serializes writers against readers.
+
     public:
         ///
         /// \brief  The default constructor.
@@ -55,25 +71,147 @@ namespace Nelobin
         Status loadFromFile (const String& a_filename,
                              const Boolean a_append = false);
 
+        ///
+        /// \fn     loadFromFileBuffer
+        /// \brief  Loads registry keys and entries from a buffer holding the whole of a registry file.
+        ///
+        /// Unlike 'loadFromBuffer', this checks the file header and version first,
+        /// as 'loadFromFile' does, so it can be given the bytes of a file which
+        /// were read by some other means.
+        ///
+        /// \param  a_buffer        The byte buffer.
+        /// \param  a_append        Optional. Should we append the new entries?
+        ///
+        /// \return A status code.
+        ///
+        Status loadFromFileBuffer (Buffer& a_buffer,
+                                   const Boolean a_append = false);
+
         ///
         /// \fn     saveToBuffer
         /// \brief  Saves the registry to the given byte buffer.
         ///
+        /// The registry is written in the buffer's current format. See the
+        /// buffer's 'setFormat' method.
+        ///
         /// \param  a_buffer        The buffer to save to.
         ///
         /// \return A status code.
         ///
-        Status saveToBuffer (Buffer& a_buffer);
+        Status saveToBuffer (Buffer& a_buffer) const;
 
         ///
         /// \fn     saveToFile
         /// \brief  Saves the registry to the given file.
         ///
         /// \param  a_filename      The name of the file.
+        /// \param  a_format        Optional. The format flags to save with. See the 'Formats' enum.
         ///
         /// \return A status code.
         ///
-        Status saveToFile (const String& a_filename);
+        Status saveToFile (const String& a_filename,
+                           const U8 a_format = Formats::Standard) const;
+
+        ///
+        /// \fn     loadFromFileAsync
+        /// \brief  Loads the given file on the default executor, then installs its contents.
+        ///
+        /// The file is read and parsed into a separate registry, so this registry
+        /// stays usable, and unchanged, in the meantime. Once parsing succeeds, the
+        /// new contents are swapped in under the write lock. If it fails, nothing
+        /// is changed.
+        ///
+        /// When appending, the new contents are added after this registry's own,
+        /// just as 'loadFromFile' would add them, and any changes made in the
+        /// meantime are kept.
+        ///
+        /// This registry must outlive the operation. Don't wait on the future while
+        /// holding this registry's locks.
+        ///
+        /// \param  a_filename      The name of the file to load.
+        /// \param  a_append        Optional. Should we append the new entries?
+        ///
+        /// \return A future which receives the status code.
+        ///
+        std::future<Status> loadFromFileAsync (const String& a_filename,
+                                               const Boolean a_append = false);
+
+        ///
+        /// \fn     saveToFileAsync
+        /// \brief  Saves the registry to the given file, on the default executor.
+        ///
+        /// A clone of the registry is taken before this method returns, and it is
+        /// the clone which is saved, so the registry can be changed straight away.
+        /// As with any read, the caller must hold at least a read lock if other
+        /// threads may be changing the registry.
+        ///
+        /// \param  a_filename      The name of the file.
+        /// \param  a_format        Optional. The format flags to save with. See the 'Formats' enum.
+        ///
+        /// \return A future which receives the status code.
+        ///
+        std::future<Status> saveToFileAsync (const String& a_filename,
+                                             const U8 a_format = Formats::Standard) const;
+
+    public:
+        ///
+        /// \fn     clone
+        /// \brief  Makes a copy of the registry, which shares its subkeys with this one.
+        ///
+        /// Only the registry's own entries are copied. Subkeys are copied later, the
+        /// first time they are reached through a non-const method of either registry,
+        /// and then only along the path to that subkey. Handles to keys and entries
+        /// taken before the copy was made should not be used to change either one.
+        ///
+        /// \return The copy.
+        ///
+        std::unique_ptr<Registry> clone () const;
+
+        ///
+        /// \fn     lockForReading
+        /// \brief  Acquires a read lock on the registry, which is shared with other readers.
+        ///
+        /// \return The lock, which is released when it goes out of scope.
+        ///
+        ReadLock lockForReading () const;
+
+        ///
+        /// \fn     lockForWriting
+        /// \brief  Acquires the registry's write lock, which excludes every other thread.
+        ///
+        /// \return The lock, which is released when it goes out of scope.
+        ///
+        WriteLock lockForWriting ();
+
+        ///
+        /// \fn     read
+        /// \brief  Calls the given function with a read lock held.
+        ///
+        /// \param  a_function      The function to call. It is given this registry, as a const key.
+        ///
+        /// \return Whatever the function returns.
+        ///
+        template <typename F>
+        inline auto read (F&& a_function) const
+        {
+            ReadLock l_lock { m_mutex };
+            return a_function(static_cast<const Key&>(*this));
+        }
+
+        ///
+        /// \fn     write
+        /// \brief  Calls the given function with the write lock held.
+        ///
+        /// \param  a_function      The function to call. It is given this registry.
+        ///
+        /// \return Whatever the function returns.
+        ///
+        template <typename F>
+        inline auto write (F&& a_function)
+        {
+            WriteLock l_lock { m_mutex };
+            return a_function(*this);
+        }
 
     };
 
@@ -0,0 +1,263 @@
+///
+/// \file   RegistryOverlay.hpp
+/// \brief  Resolves lookups through a stack of registries, without merging them.
+///
+
+#pragma once
+
+#include <unordered_map>
+#include <Nelobin/Registry.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  RegistryOverlay
+    /// \brief  Resolves lookups through a stack of registries, without merging them.
+    ///
+    /// Layers are stacked bottom to top, such as defaults, then site settings,
+    /// then host settings, then overrides. A lookup is resolved from the top
+    /// layer down: the topmost layer holding an entry with the requested name
+    /// wins, even if a lower layer holds an entry of the requested type. The
+    /// layers themselves are never copied or changed.
+    ///
+    /// Lookups are addressed by path. The components of a path are separated by
+    /// slashes, and each component may end with a colon and an instance ID, as
+    /// in "Servers/Server:2/Port". A component without an instance ID refers to
+    /// instance 0. The path of an entry ends with the entry's name.
+    ///
+    /// Resolved paths are cached. The cache is dropped as soon as any layer is
+    /// changed structurally - an entry or key is added, renamed or removed - so
+    /// layers may still be changed, under their write locks, while the overlay
+    /// is in use. Changing an entry's value does not drop the cache; the new
+    /// value is seen straight away.
+    ///
+    /// An overlay is meant to be used by one thread at a time. Threads sharing
+    /// the same layers should each use their own overlay, and hold the layers'
+    /// read locks while using it.
+    ///
+    class _NELOBIN_API RegistryOverlay
+    {
+    public:
+        ///
+        /// \class  View
+        /// \brief  A key, as seen through every layer of the overlay.
+        ///
+        /// A view holds the key found at the same path in each layer, from the
+        /// top layer down. It is only valid until one of the layers is changed
+        /// structurally.
+        ///
+        class _NELOBIN_API View
+        {
+        private:
+            friend class RegistryOverlay;
+
+        private:
+            std::vector<const Key*>     m_keys;     ///< The key in each layer, top layer first, or null where it is missing.
+
+        private:
+            View (std::vector<const Key*>&& a_keys);
+
+        public:
+            ///
+            /// \fn     tryGetEntry
+            /// \brief  Gets the entry with the given name from the topmost layer holding one.
+            ///
+            /// \param  a_name      The name of the entry.
+            ///
+            /// \return The entry, or null if no layer holds it, or the topmost one is of another type.
+            ///
+            template <typename T>
+            inline const Entry<T>* tryGetEntry (const String& a_name) const
+            {
+                const EntryBase* lp_entry = findEntry(a_name);
+                if (lp_entry == nullptr || lp_entry->getAlias() != TT_Type<T>::Alias)
+                    return nullptr;
+
+                return static_cast<const Entry<T>*>(lp_entry);
+            }
+
+            ///
+            /// \fn     getOr
+            /// \brief  Gets the value of the entry with the given name, or a fallback value.
+            ///
+            template <typename T>
+            inline T getOr (const String& a_name,
+                            const T& a_default) const
+            {
+                const Entry<T>* lp_entry = tryGetEntry<T>(a_name);
+                return (lp_entry != nullptr) ? lp_entry->get() : a_default;
+            }
+
+            ///
+            /// \fn     getKey
+            /// \brief  Gets the subkey with the given name and instance ID, as seen through every layer.
+            ///
+            /// \param  a_name      The name of the subkey.
+            /// \param  a_instance  Optional. The subkey's instance ID.
+            ///
+            /// \return The subkey's view. It is empty if no layer holds the subkey.
+            ///
+            View getKey (const String& a_name,
+                         const U32 a_instance = 0) const;
+
+            ///
+            /// \fn     getLayerKey
+            /// \brief  Gets this key as held by the given layer.
+            ///
+            /// \param  a_layer     The layer's index, counting from the bottom layer.
+            ///
+            /// \return The key, or null if the layer doesn't hold it.
+            ///
+            const Key* getLayerKey (const Size a_layer) const;
+
+            ///
+            /// \fn     isEmpty
+            /// \brief  Checks whether no layer holds this key.
+            ///
+            Boolean isEmpty () const;
+
+        private:
+            const EntryBase* findEntry (const String& a_name) const;
+
+        };
+
+    private:
+        std::vector<const Registry*>                            m_layers;       ///< The layers, bottom layer first.
+        mutable std::vector<Size>                               m_revisions;    ///< The revision of each layer when the caches were filled.
+        mutable std::unordered_map<String, std::vector<const Key*>> m_keyCache; ///< Maps key paths to the key in each layer, top layer first.
+        mutable std::unordered_map<String, const EntryBase*>    m_entryCache;   ///< Maps entry paths to the topmost entry found.
+
+    private:
+        ///
+        /// \fn     validate
+        /// \brief  Drops the caches if any layer has changed since they were filled.
+        ///
+        void validate () const;
+
+        ///
+        /// \fn     resolveKey
+        /// \brief  Finds the key at the given path in each layer, consulting the cache first.
+        ///
+        /// \return The key in each layer, top layer first, or null where it is missing.
+        ///
+        const std::vector<const Key*>& resolveKey (const String& a_path) const;
+
+        ///
+        /// \fn     resolveEntry
+        /// \brief  Finds the topmost entry at the given path, consulting the cache first.
+        ///
+        /// \return The entry, or null if no layer holds it.
+        ///
+        const EntryBase* resolveEntry (const String& a_path) const;
+
+    public:
+        ///
+        /// \brief  The default constructor. Starts with no layers.
+        ///
+        RegistryOverlay ();
+
+        ///
+        /// \brief  Constructs an overlay from the given layers, bottom layer first.
+        ///
+        RegistryOverlay (std::initializer_list<const Registry*> a_layers);
+
+    public:
+        ///
+        /// \fn     pushLayer
+        /// \brief  Stacks the given registry on top of the other layers.
+        ///
+        /// The registry must outlive the overlay, or be popped before it is destroyed.
+        ///
+        /// \param  a_registry  The new top layer.
+        ///
+        void pushLayer (const Registry& a_registry);
+
+        ///
+        /// \fn     popLayer
+        /// \brief  Removes the top layer.
+        ///
+        void popLayer ();
+
+        ///
+        /// \fn     getEntry
+        /// \brief  Gets the entry at the given path from the topmost layer holding one.
+        ///
+        /// \param  a_path      The entry's path, such as "Physics/Gravity".
+        ///
+        /// \return The entry in question, or the "null" entry.
+        ///
+        template <typename T>
+        inline const Entry<T>& getEntry (const String& a_path) const
+        {
+            const EntryBase* lp_entry = resolveEntry(a_path);
+            if (lp_entry == nullptr)
+            {
+                _Nelobin_Error("RegistryOverlay::getEntry(): Entry, \"" << a_path << "\", not found in any layer.");
+                return Entry<T>::getNull();
+            }
+
+            if (lp_entry->getAlias() != TT_Type<T>::Alias)
+            {
+                _Nelobin_Error("RegistryOverlay::getEntry(): Entry, \"" << a_path << "\", was found, but a type mismatch occured.");
+                return Entry<T>::getNull();
+            }
+
+            return *static_cast<const Entry<T>*>(lp_entry);
+        }
+
+        ///
+        /// \fn     tryGetEntry
+        /// \brief  Gets the entry at the given path, if it exists.
+        ///
+        /// Unlike 'getEntry', this method reports nothing if the entry is missing
+        /// or of another type.
+        ///
+        template <typename T>
+        inline const Entry<T>* tryGetEntry (const String& a_path) const
+        {
+            const EntryBase* lp_entry = resolveEntry(a_path);
+            if (lp_entry == nullptr || lp_entry->getAlias() != TT_Type<T>::Alias)
+                return nullptr;
+
+            return static_cast<const Entry<T>*>(lp_entry);
+        }
+
+        ///
+        /// \fn     getOr
+        /// \brief  Gets the value of the entry at the given path, or a fallback value.
+        ///
+        template <typename T>
+        inline T getOr (const String& a_path,
+                        const T& a_default) const
+        {
+            const Entry<T>* lp_entry = tryGetEntry<T>(a_path);
+            return (lp_entry != nullptr) ? lp_entry->get() : a_default;
+        }
+
+        ///
+        /// \fn     getKey
+        /// \brief  Gets the key at the given path, as seen through every layer.
+        ///
+        /// \param  a_path      The key's path. Leave blank for the layers' root keys.
+        ///
+        /// \return The key's view. It is empty if no layer holds the key.
+        ///
+        View getKey (const String& a_path) const;
+
+        ///
+        /// \fn     invalidate
+        /// \brief  Drops the cached paths.
+        ///
+        /// This is never needed for correctness, but frees the cache's memory.
+        ///
+        void invalidate () const;
+
+    public:
+        inline Size getLayerCount () const { return m_layers.size(); }
+        inline const Registry& getLayer (const Size a_index) const { return *m_layers[a_index]; }
+
+    };
+
+}
@@ -0,0 +1,178 @@
+///
+/// \file   RegistryPatcher.hpp
+/// \brief  Overwrites fixed-width entries in a registry file, in place.
+///
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <Nelobin/MappedFile.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  RegistryPatcher
+    /// \brief  Overwrites fixed-width entries in a registry file, in place.
+    ///
+    /// The patcher maps a registry file, and scans it once to find where the
+    /// value of each fixed-width entry - the 8-, 16- and 32-bit integers, and
+    /// floats - is stored. Setting one of those entries then writes its new
+    /// value straight into the mapped file, in the file's byte order, without
+    /// loading or saving the rest of the registry. The change can optionally be
+    /// flushed to disk before 'set' returns.
+    ///
+    /// Entries are addressed by path, as in "Stats/Counter" or "Servers/Server:2/Port".
+    /// String entries, which would change the size of the file, can't be patched.
+    ///
+    /// Only files in the standard layout (version 1.0) can be patched. In the
+    /// compact layouts, the size of an integer depends on its value.
+    ///
+    /// Writes are not atomic with respect to other processes reading the file.
+    ///
+    class _NELOBIN_API RegistryPatcher
+    {
+    private:
+        ///
+        /// \struct Slot
+        /// \brief  Where the value of a fixed-width entry is stored.
+        ///
+        struct Slot
+        {
+            Size    m_offset;       ///< The offset of the value from the start of the file.
+            U8      m_alias;        ///< The entry's type alias.
+        };
+
+    private:
+        MappedFile                          m_file;     ///< The mapped registry file.
+        std::unordered_map<String, Slot>    m_slots;    ///< Maps canonical entry paths to their values.
+
+    private:
+        ///
+        /// \fn     findSlot
+        /// \brief  Finds the value of the entry at the given path, and checks its type.
+        ///
+        /// \return A status code.
+        ///
+        Status findSlot (const String& a_path,
+                         const U8 a_alias,
+                         Size& a_offset) const;
+
+        ///
+        /// \fn     write
+        /// \brief  Writes the given value, as a 32-bit pattern, to the entry at the given path.
+        ///
+        Status write (const String& a_path,
+                      const U8 a_alias,
+                      const U32 a_bits,
+                      const Boolean a_sync);
+
+        ///
+        /// \fn     read
+        /// \brief  Reads the value of the entry at the given path, as a 32-bit pattern.
+        ///
+        Status read (const String& a_path,
+                     const U8 a_alias,
+                     U32& a_bits) const;
+
+    public:
+        ///
+        /// \brief  The default constructor. Opens nothing.
+        ///
+        RegistryPatcher ();
+
+        RegistryPatcher (const RegistryPatcher&) = delete;
+        RegistryPatcher& operator= (const RegistryPatcher&) = delete;
+
+    public:
+        ///
+        /// \fn     open
+        /// \brief  Maps the given registry file, and finds its fixed-width entries.
+        ///
+        /// \param  a_filename      The name of the file.
+        ///
+        /// \return A status code.
+        ///
+        Status open (const String& a_filename);
+
+        ///
+        /// \fn     close
+        /// \brief  Releases the file. Changes not yet flushed are still written eventually.
+        ///
+        void close ();
+
+        ///
+        /// \fn     set
+        /// \brief  Overwrites the value of the entry at the given path.
+        ///
+        /// \param  a_path      The entry's path.
+        /// \param  a_value     The entry's new value.
+        /// \param  a_sync      Optional. Should the change be flushed to disk before returning?
+        ///
+        /// \return A status code. 'Status::NotFound' if there is no such entry, and
+        ///         'Status::TypeMismatch' if it is of another type.
+        ///
+        template <typename T>
+        inline Status set (const String& a_path,
+                           const T& a_value,
+                           const Boolean a_sync = false)
+        {
+            static_assert(TT_Type<T>::Valid == true && std::is_same<T, String>::value == false,
+                          "Only fixed-width entries can be patched.");
+
+            U32 l_bits = 0;
+            if constexpr (std::is_same<T, Float>::value == true)
+                std::memcpy(&l_bits, &a_value, sizeof(l_bits));
+            else
+                l_bits = static_cast<U32>(a_value);
+
+            return write(a_path, TT_Type<T>::Alias, l_bits, a_sync);
+        }
+
+        ///
+        /// \fn     get
+        /// \brief  Reads the current value of the entry at the given path.
+        ///
+        /// \param  a_path      The entry's path.
+        /// \param  a_value     Filled with the entry's value, if it is found.
+        ///
+        /// \return A status code.
+        ///
+        template <typename T>
+        inline Status get (const String& a_path,
+                           T& a_value) const
+        {
+            static_assert(TT_Type<T>::Valid == true && std::is_same<T, String>::value == false,
+                          "Only fixed-width entries can be patched.");
+
+            U32 l_bits = 0;
+            Status l_status = read(a_path, TT_Type<T>::Alias, l_bits);
+            if (l_status != Status::OK)
+                return l_status;
+
+            if constexpr (std::is_same<T, Float>::value == true)
+                std::memcpy(&a_value, &l_bits, sizeof(a_value));
+            else
+                a_value = static_cast<T>(l_bits);
+
+            return Status::OK;
+        }
+
+        ///
+        /// \fn     sync
+        /// \brief  Flushes every change made so far to disk.
+        ///
+        /// \return A status code.
+        ///
+        Status sync ();
+
+    public:
+        inline Size getEntryCount () const { return m_slots.size(); }
+        inline Boolean isOpen () const { return m_file.isOpen(); }
+
+    };
+
+}
@@ -0,0 +1,130 @@
+///
+/// \file   RegistrySnapshot.hpp
+/// \brief  Publishes read-only registries to reader threads without locking them.
+///
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <Nelobin/Registry.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \class  RegistrySnapshot
+    /// \brief  Publishes read-only registries to reader threads without locking them.
+    ///
+    /// A snapshot holds the current version of a registry, which is never changed
+    /// once it is published. Readers take a 'Reader' handle, which pins the version
+    /// that was current at the time. Publishing a new version swaps it in atomically,
+    /// then waits for every reader still pinning an older version to let go before
+    /// destroying it.
+    ///
+    /// Reclamation is epoch-based. Readers register in one of two counters, picked by
+    /// the parity of the current epoch. A publisher advances the epoch, then waits
+    /// for the counter of the previous parity to drain. Taking a reader handle never
+    /// blocks: it only retries if a publish happens at the same moment.
+    ///
+    /// Reading through a handle takes no lock either. Lookups by name probe the
+    /// atom table, which takes no lock, so a reload interning new names doesn't
+    /// stall readers. Readers which look the same names up often can probe them
+    /// once with 'Atom::probe' and use the key's atom-keyed seek methods.
+    ///
+    /// Reader handles should be short-lived, since publishing waits for them.
+    ///
+    class _NELOBIN_API RegistrySnapshot
+    {
+    public:
+        ///
+        /// \class  Reader
+        /// \brief  Pins the registry which was current when it was created.
+        ///
+        class _NELOBIN_API Reader
+        {
+        private:
+            friend class RegistrySnapshot;
+
+        private:
+            const RegistrySnapshot*     mp_snapshot;    ///< The snapshot this reader is registered with.
+            U32                         m_slot;         ///< The reader counter this reader is registered in.
+            const Registry*             mp_registry;    ///< The registry this reader pins.
+
+        private:
+            Reader (const RegistrySnapshot* ap_snapshot,
+                    const U32 a_slot,
+                    const Registry* ap_registry);
+
+        public:
+            Reader (Reader&& a_other);
+            ~Reader ();
+
+            Reader (const Reader&) = delete;
+            Reader& operator= (const Reader&) = delete;
+            Reader& operator= (Reader&&) = delete;
+
+        public:
+            inline const Registry* get () const { return mp_registry; }
+            inline const Registry& operator* () const { return *mp_registry; }
+            inline const Registry* operator-> () const { return mp_registry; }
+            inline explicit operator bool () const { return mp_registry != nullptr; }
+
+        };
+
+    private:
+        std::atomic<const Registry*>        mp_current;     ///< The current version of the registry.
+        std::atomic<U32>                    m_epoch;        ///< Advanced every time a version is published.
+        alignas(64) mutable std::atomic<U32> m_readers[2];  ///< The number of readers registered under each epoch parity.
+        alignas(64) std::mutex              m_publishMutex; ///< Serializes publishers.
+
+    public:
+        ///
+        /// \brief  The default constructor. Starts with no registry published.
+        ///
+        RegistrySnapshot ();
+
+        ///
+        /// \brief  The destructor. No readers may be left when it is called.
+        ///
+        ~RegistrySnapshot ();
+
+        RegistrySnapshot (const RegistrySnapshot&) = delete;
+        RegistrySnapshot& operator= (const RegistrySnapshot&) = delete;
+
+    public:
+        ///
+        /// \fn     read
+        /// \brief  Pins the current registry, so that it can be read without locking.
+        ///
+        /// \return A reader handle. It is empty if no registry has been published.
+        ///
+        Reader read () const;
+
+        ///
+        /// \fn     publish
+        /// \brief  Swaps in a new version of the registry.
+        ///
+        /// This method returns once every reader of the previous version has let
+        /// go of it, and it has been destroyed.
+        ///
+        /// \param  a_registry      The new version. It must not be changed afterwards.
+        ///
+        void publish (std::unique_ptr<Registry> a_registry);
+
+        ///
+        /// \fn     reload
+        /// \brief  Loads the given file into a fresh registry, then publishes it.
+        ///
+        /// If the file can't be loaded, the current version stays published.
+        ///
+        /// \param  a_filename      The name of the file to load.
+        ///
+        /// \return A status code.
+        ///
+        Status reload (const String& a_filename);
+
+    };
+
+}
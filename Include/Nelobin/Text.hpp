@@ -0,0 +1,103 @@
+///
+/// \file   Text.hpp
+/// \brief  Formats entry values, and whole keys, as text.
+///
+
+#pragma once
+
+#include <iosfwd>
+#include <Nelobin/Key.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \fn     appendValue
+    /// \brief  Appends the text form of a value to the given string.
+    ///
+    /// Numbers are formatted with 'std::to_chars', so nothing is allocated beyond
+    /// the string's own growth, and the locale is never consulted. Floats are
+    /// written in the shortest form which reads back as the same value.
+    ///
+    /// \param  a_text          The string to append to.
+    /// \param  a_value         The value to format.
+    ///
+    _NELOBIN_API void appendValue (String& a_text, const S8 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const S16 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const S32 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const U8 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const U16 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const U32 a_value);
+    _NELOBIN_API void appendValue (String& a_text, const Float a_value);
+
+    ///
+    /// \fn     appendQuoted
+    /// \brief  Appends a string to the given string, quoted, with quotes, backslashes
+    ///         and control characters escaped, as string values are dumped.
+    ///
+    /// \param  a_text          The string to append to.
+    /// \param  ap_data         The bytes of the string to quote.
+    /// \param  a_length        The number of bytes.
+    ///
+    _NELOBIN_API void appendQuoted (String& a_text, const char* ap_data, const Size a_length);
+
+    ///
+    /// \fn     getShortTypeName
+    /// \brief  Gets the short name of a type alias, such as "U32", as written in dumped text.
+    ///
+    /// \param  a_alias         The type alias.
+    ///
+    /// \return The type's short name, or "Unknown".
+    ///
+    _NELOBIN_API const char* getShortTypeName (const U8 a_alias);
+
+    ///
+    /// \fn     appendEntry
+    /// \brief  Appends the text form of an entry's value to the given string.
+    ///
+    /// The text is the same as that returned by 'stringifyEntryBase'. String
+    /// values are appended as they are, without quotes.
+    ///
+    /// \param  a_text          The string to append to.
+    /// \param  a_entry         The entry, in its base form.
+    ///
+    _NELOBIN_API void appendEntry (String& a_text, const EntryBase& a_entry);
+
+    ///
+    /// \fn     dumpText
+    /// \brief  Writes a key, and everything beneath it, as indented text.
+    ///
+    /// Each entry is written on a line of its own, as its name, its type and its
+    /// value, with string values quoted and escaped. Each subkey is written as its
+    /// name, and its instance ID if not zero, in brackets, followed by its own
+    /// contents, indented. A key other than the root starts with a line of its own:
+    /// \code
+    /// [Developer]
+    ///     Name (String) = "Dennis"
+    ///     [Project:1]
+    ///         Stars (U32) = 42
+    /// \endcode
+    ///
+    /// The text is gathered into one reused chunk and written out whenever the
+    /// chunk fills, so dumping a large registry allocates almost nothing.
+    ///
+    /// \param  a_key           The key to write.
+    /// \param  a_stream        The stream to write to.
+    ///
+    /// \return 'Status::OK', or 'Status::FileSaveError' if the stream fails.
+    ///
+    _NELOBIN_API Status dumpText (const Key& a_key, std::ostream& a_stream);
+
+    ///
+    /// \fn     dumpText
+    /// \brief  Writes a key, and everything beneath it, as indented text, to a file descriptor.
+    ///
+    /// \param  a_key           The key to write.
+    /// \param  a_descriptor    The file descriptor to write to, such as that of a socket or pipe.
+    ///
+    /// \return 'Status::OK', or 'Status::FileSaveError' if writing fails.
+    ///
+    _NELOBIN_API Status dumpText (const Key& a_key, const int a_descriptor);
+
+}
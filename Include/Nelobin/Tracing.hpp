@@ -0,0 +1,143 @@
+///
+/// \file   Tracing.hpp
+/// \brief  Records timed spans of the library's work, for viewing as a Chrome trace.
+///
+
+#pragma once
+
+#include <atomic>
+#include <Nelobin/Types.hpp>
+#include <Nelobin/Atom.hpp>
+#include <Nelobin/Error.hpp>
+#include <Nelobin/Export.hpp>
+
+///
+/// \def    _Nelobin_Trace
+/// \brief  Records the rest of the enclosing scope as a span with the given name.
+///
+/// \def    _Nelobin_TraceKey
+/// \brief  As above, but for a span covering a single key, which is subject to sampling.
+///
+/// \def    _Nelobin_TraceDetail
+/// \brief  Attaches the given name, as an atom, to the span started in the enclosing scope.
+///
+/// Spans are only recorded when 'NELOBIN_TRACING' is defined, and tracing has
+/// been started. Otherwise, these macros expand to nothing.
+///
+#if defined(NELOBIN_TRACING)
+# define _Nelobin_Trace(a_name) \
+    Nelobin::Private::TraceSpan l_traceSpan { a_name, false }
+# define _Nelobin_TraceKey(a_name) \
+    Nelobin::Private::TraceSpan l_traceSpan { a_name, true }
+# define _Nelobin_TraceDetail(a_atom) \
+    l_traceSpan.setDetail(a_atom)
+#else
+# define _Nelobin_Trace(a_name) do { } while (false)
+# define _Nelobin_TraceKey(a_name) do { } while (false)
+# define _Nelobin_TraceDetail(a_atom) do { } while (false)
+#endif
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        /// Set while tracing. Checked by every span before doing anything else.
+        extern _NELOBIN_API std::atomic<Boolean> G_TRACING;
+
+        ///
+        /// \fn     beginTraceSpan
+        /// \brief  Decides whether a span is recorded, and gets its start time.
+        ///
+        /// \return True if the span should be recorded.
+        ///
+        _NELOBIN_API Boolean beginTraceSpan (const Boolean a_key,
+                                             U64& a_start);
+
+        ///
+        /// \fn     endTraceSpan
+        /// \brief  Records a finished span on the calling thread.
+        ///
+        _NELOBIN_API void endTraceSpan (const char* ap_name,
+                                        const Atom& a_detail,
+                                        const U64 a_start);
+
+        ///
+        /// \class  TraceSpan
+        /// \brief  Records its own lifetime as a span, if tracing.
+        ///
+        class TraceSpan
+        {
+        private:
+            const char*     mp_name;        ///< The span's name. Must be a string literal.
+            Atom            m_detail;       ///< An optional name, such as that of the key being parsed.
+            U64             m_start;        ///< When the span started, in nanoseconds since tracing began.
+            Boolean         m_active;       ///< Is this span being recorded?
+
+        public:
+            TraceSpan (const char* ap_name,
+                       const Boolean a_key) :
+                mp_name     { ap_name },
+                m_start     { 0 },
+                m_active    { false }
+            {
+                if (G_TRACING.load(std::memory_order_relaxed) == true)
+                    m_active = beginTraceSpan(a_key, m_start);
+            }
+
+            ~TraceSpan ()
+            {
+                if (m_active == true)
+                    endTraceSpan(mp_name, m_detail, m_start);
+            }
+
+            TraceSpan (const TraceSpan&) = delete;
+            TraceSpan& operator= (const TraceSpan&) = delete;
+
+        public:
+            inline void setDetail (const Atom& a_detail) { m_detail = a_detail; }
+
+        };
+
+    }
+
+    ///
+    /// \fn     startTracing
+    /// \brief  Discards any spans recorded so far, and starts recording new ones.
+    ///
+    /// Spans covering single keys are numerous, so they can be sampled: with a
+    /// sampling interval of N, only every Nth key span on each thread is kept.
+    ///
+    /// \param  a_keySampling       Optional. The key span sampling interval. Zero records no key spans.
+    ///
+    _NELOBIN_API void startTracing (const U32 a_keySampling = 1);
+
+    ///
+    /// \fn     stopTracing
+    /// \brief  Stops recording spans. Those already recorded are kept.
+    ///
+    _NELOBIN_API void stopTracing ();
+
+    ///
+    /// \fn     saveTrace
+    /// \brief  Saves the spans recorded so far as a Chrome trace, which Perfetto can also open.
+    ///
+    /// \param  a_filename          The name of the file.
+    ///
+    /// \return A status code.
+    ///
+    _NELOBIN_API Status saveTrace (const String& a_filename);
+
+    ///
+    /// \fn     isTracing
+    /// \brief  Checks to see if spans are being recorded.
+    ///
+    _NELOBIN_API Boolean isTracing ();
+
+    ///
+    /// \fn     isTracingAvailable
+    /// \brief  Checks to see if the library was built with tracing.
+    ///
+    _NELOBIN_API Boolean isTracingAvailable ();
+
+}
@@ -20,6 +20,7 @@ namespace Nelobin
     using U8        = std::uint8_t;
     using U16       = std::uint16_t;
     using U32       = std::uint32_t;
+    using U64       = std::uint64_t;
     using Float     = float;
     using String    = std::string;
     using Boolean   = bool;
@@ -30,7 +31,38 @@ namespace Nelobin
     const U32 G_ENTRY_HEADER    = 0x9E708199;
     const U32 G_KEY_HEADER      = 0x9E70819E;
     const U32 G_REGISTRY_HEADER = 0x9E70819F;
+    const U32 G_COLUMNS_HEADER  = 0x9E70819D;
     const U16 G_VERSION         = 0x0100;
+    const U16 G_VERSION_COMPACT = 0x0101;
+
+    // Frozen Image Constants
+    //
+    // These begin the in-memory images built by the FrozenRegistry class.
+    const U32 G_FROZEN_HEADER   = 0x9E70819C;
+    const U32 G_FROZEN_VERSION  = 0x00000001;
+
+    // Compact Record Tags
+    //
+    // In the compact layout, these one-byte tags take the place of the
+    // four-byte entry and key headers above.
+    const U8  G_ENTRY_TAG       = 0x01;
+    const U8  G_KEY_TAG         = 0x02;
+    const U8  G_COLUMNS_TAG     = 0x03;
+
+    ///
+    /// \enum   Formats
+    /// \brief  Enumerates the layouts in which a registry can be serialized.
+    ///
+    /// Any format other than 'Standard' is written with the 'G_VERSION_COMPACT'
+    /// version number, followed by a byte holding these flags.
+    ///
+    enum Formats : U8
+    {
+        Standard    = 0x00,     ///< The fixed-width layout of version 1.0.
+        Compact     = 0x01,     ///< Variable-length integers and one-byte record tags.
+        NameTable   = 0x02,     ///< Names are written once, up front, and referred to by index.
+        Columnar    = 0x04      ///< Runs of same-named subkeys with identical entries are written as columns.
+    };
 
     ///
     /// \enum   TypeAlias
@@ -94,4 +126,29 @@ namespace Nelobin
     ///
     _NELOBIN_API String stringifyType (const U8 a_type);
 
+    /// The deepest nesting of keys which the library reads from untrusted input.
+    /// Files and documents nesting keys any deeper are rejected as malformed.
+    const U32 G_MAX_KEY_DEPTH = 256;
+
+    ///
+    /// \fn     nextPathComponent
+    /// \brief  Reads the next component of a path to a key or entry.
+    ///
+    /// The components of a path are separated by slashes, and each component may
+    /// end with a colon and an instance ID, as in "Servers/Server:2/Port". A
+    /// component without an instance ID refers to instance 0. Empty components,
+    /// such as those left by a leading slash, are skipped.
+    ///
+    /// \param  a_path              The path.
+    /// \param  a_position          The position to read from. Advanced past the component read.
+    /// \param  a_name              Filled with the component's name.
+    /// \param  a_instance          Filled with the component's instance ID.
+    ///
+    /// \return True if a component was read, or false at the end of the path.
+    ///
+    _NELOBIN_API Boolean nextPathComponent (const String& a_path,
+                                            Size& a_position,
+                                            String& a_name,
+                                            U32& a_instance);
+
 }
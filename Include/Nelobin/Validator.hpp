@@ -0,0 +1,175 @@
+///
+/// \file   Validator.hpp
+/// \brief  Checks untrusted registry files before they are parsed.
+///
+
+#pragma once
+
+#include <Nelobin/Buffer.hpp>
+#include <Nelobin/Export.hpp>
+
+namespace Nelobin
+{
+
+    ///
+    /// \struct ValidationLimits
+    /// \brief  The limits a registry file must keep within to pass validation.
+    ///
+    struct ValidationLimits
+    {
+        U32     m_maxDepth;             ///< The deepest nesting of keys allowed. Capped at 'G_MAX_KEY_DEPTH'.
+        U32     m_maxNameLength;        ///< The longest name of a key or entry allowed, in bytes.
+        U32     m_maxStringLength;      ///< The longest string value allowed, in bytes.
+
+        ValidationLimits () :
+            m_maxDepth          { 64 },
+            m_maxNameLength     { 4096 },
+            m_maxStringLength   { 64 * 1024 * 1024 }
+        {}
+    };
+
+    ///
+    /// \struct RecordView
+    /// \brief  A key or entry met while walking a registry file.
+    ///
+    /// The name and string value point straight into the file's bytes, and are
+    /// not null-terminated. Integer values are held in 32 bits, sign-extended if
+    /// the type is signed, and delta-encoded columns are already decoded.
+    ///
+    struct RecordView
+    {
+        const char*     mp_name;        ///< The record's name.
+        Size            m_nameLength;   ///< The length of the record's name, in bytes.
+        Size            m_offset;       ///< The offset of the record's first byte.
+        U32             m_depth;        ///< The number of keys the record is nested in, not counting the root.
+        U32             m_rowCount;     ///< If the record is, or is in, a row of a block of columns, the number of rows in the block.
+        U8              m_alias;        ///< An entry's type alias.
+        U32             m_integer;      ///< An integer entry's value.
+        Float           m_float;        ///< A floating-point entry's value.
+        const char*     mp_string;      ///< A string entry's value.
+        Size            m_stringLength; ///< The length of a string entry's value, in bytes.
+    };
+
+    ///
+    /// \class  RecordVisitor
+    /// \brief  Receives the keys and entries of a registry file as it is walked.
+    ///
+    /// Each method returns true to carry on walking, or false to stop.
+    ///
+    class _NELOBIN_API RecordVisitor
+    {
+    public:
+        virtual ~RecordVisitor () = default;
+
+        ///
+        /// \fn     enterKey
+        /// \brief  Called when a key is reached, before its contents.
+        ///
+        virtual Boolean enterKey (const RecordView&) { return true; }
+
+        ///
+        /// \fn     leaveKey
+        /// \brief  Called after a key's contents, with the key as it was given to
+        ///         'enterKey', and the offset just past the key's last byte.
+        ///
+        /// The rows of a block of columns share the bytes of the whole block, so
+        /// each is given the block's offset, and the block's end.
+        ///
+        virtual Boolean leaveKey (const RecordView&, const Size) { return true; }
+
+        ///
+        /// \fn     visitEntry
+        /// \brief  Called for each entry, in the order the entries are stored.
+        ///
+        virtual Boolean visitEntry (const RecordView&) { return true; }
+    };
+
+    ///
+    /// \class  Validator
+    /// \brief  Checks untrusted registry files before they are parsed.
+    ///
+    /// A registry file's lengths and counts are read straight from the file, so a
+    /// corrupt or malicious file can ask the parser to read past its end, nest its
+    /// keys deep enough to exhaust the stack, or hold strings too large to allocate.
+    /// The validator checks the whole of a file - its header and format flags, and
+    /// every record's header, name, type alias, length and count - in one pass,
+    /// without allocating or building anything.
+    ///
+    /// Once a buffer has passed, it can be marked as trusted with the buffer's
+    /// 'setTrusted' method, and parsed without checking the bounds of each field:
+    /// \code
+    /// if (Nelobin::Validator::validate(l_buffer) == Nelobin::Status::OK)
+    /// {
+    ///     l_buffer.setTrusted(true);
+    ///     l_registry.loadFromFileBuffer(l_buffer);
+    /// }
+    /// \endcode
+    ///
+    /// The validator checks a file's structure, not its meaning. The parser still
+    /// rejects files which, for instance, use a reserved name for a key.
+    ///
+    class _NELOBIN_API Validator
+    {
+    public:
+        ///
+        /// \fn     validate
+        /// \brief  Checks that the given bytes hold a well-formed registry file.
+        ///
+        /// \param  ap_data         The bytes of the file.
+        /// \param  a_size          The number of bytes.
+        /// \param  a_limits        Optional. The limits the file must keep within.
+        /// \param  ap_offset       Optional. Filled with the offset at which the file was found to be bad, if it fails.
+        ///
+        /// \return 'Status::OK' if the file is well-formed, or 'Status::FileParseError' if not.
+        ///
+        static Status validate (const void* ap_data,
+                                const Size a_size,
+                                const ValidationLimits& a_limits = ValidationLimits {},
+                                Size* ap_offset = nullptr);
+
+        ///
+        /// \fn     validate
+        /// \brief  Checks that the given buffer holds a well-formed registry file, from its start.
+        ///
+        /// \param  a_buffer        The buffer.
+        /// \param  a_limits        Optional. The limits the file must keep within.
+        /// \param  ap_offset       Optional. Filled with the offset at which the file was found to be bad, if it fails.
+        ///
+        /// \return 'Status::OK' if the file is well-formed, or 'Status::FileParseError' if not.
+        ///
+        static Status validate (const Buffer& a_buffer,
+                                const ValidationLimits& a_limits = ValidationLimits {},
+                                Size* ap_offset = nullptr);
+
+        ///
+        /// \fn     walk
+        /// \brief  Checks the given bytes as 'validate' does, passing each key and entry
+        ///         to a visitor as it is reached.
+        ///
+        /// Nothing is built, and apart from a name table or a block of columns'
+        /// read positions, nothing is allocated, so a file of any size can be
+        /// walked in a small, fixed amount of memory. Records are passed on as
+        /// soon as they are checked, so a visitor may be given the start of a file
+        /// which later turns out to be malformed.
+        ///
+        /// The rows of a block of columns are passed on one at a time, with their
+        /// entries, just as if they had been stored as separate keys.
+        ///
+        /// \param  ap_data         The bytes of the file.
+        /// \param  a_size          The number of bytes.
+        /// \param  a_visitor       The visitor to pass each record to.
+        /// \param  a_limits        Optional. The limits the file must keep within.
+        /// \param  ap_offset       Optional. Filled with the offset at which the file was found to be bad, if it fails.
+        ///
+        /// \return 'Status::OK' if the file is well-formed, or the visitor stopped the
+        ///         walk, or 'Status::FileParseError' if the file is malformed.
+        ///
+        static Status walk (const void* ap_data,
+                            const Size a_size,
+                            RecordVisitor& a_visitor,
+                            const ValidationLimits& a_limits = ValidationLimits {},
+                            Size* ap_offset = nullptr);
+
+    };
+
+}
@@ -0,0 +1,277 @@
+///
+/// \file   Atom.cpp
+///
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Nelobin/Atom.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        ///
+        /// \class  AtomTable
+        /// \brief  Maps names to atom IDs, and atom IDs back to names.
+        ///
+        /// Names are looked up far more often than they are added, often from many
+        /// threads at once, so lookups take no lock and write nothing shared.
+        ///
+        /// Names are found through an open-addressed index whose slots each hold a
+        /// name's hash and its ID plus one, or zero if empty. A slot, once filled,
+        /// never changes. When the index fills up, a larger copy is published in
+        /// its place; the old one is kept until the table is destroyed, since a
+        /// lookup may still be reading it.
+        ///
+        /// The names themselves live in a deque, and never move. IDs are mapped
+        /// back to them through a segmented array whose segments double in size
+        /// and, once published, never move either.
+        ///
+        /// Only adding a name takes the lock.
+        ///
+        class AtomTable
+        {
+        private:
+            static const U32 G_FIRST_SEGMENT = 64;      ///< The size of the first segment.
+            static const U32 G_SEGMENT_COUNT = 27;      ///< Enough segments to cover every 32-bit ID.
+            static const U32 G_FIRST_CAPACITY = 256;    ///< The number of slots in the first index.
+
+            ///
+            /// \struct Index
+            /// \brief  An open-addressed index of the interned names.
+            ///
+            struct Index
+            {
+                const Size                                  m_mask;     ///< The number of slots, less one.
+                std::unique_ptr<std::atomic<std::uint64_t>[]>  m_slots;    ///< Each name's hash and ID plus one.
+
+                explicit Index (const Size a_capacity) :
+                    m_mask  { a_capacity - 1 },
+                    m_slots { new std::atomic<std::uint64_t>[a_capacity] }
+                {
+                    for (Size i = 0; i < a_capacity; ++i)
+                        m_slots[i].store(0, std::memory_order_relaxed);
+                }
+            };
+
+        private:
+            std::mutex                              m_mutex;        ///< Serializes the adding of names.
+            std::deque<String>                      m_names;        ///< The interned names, in ID order.
+            std::vector<std::unique_ptr<Index>>     m_indices;      ///< Every index built, the current one last.
+            std::atomic<const Index*>               m_index;        ///< The current index.
+            std::atomic<const String**>             m_segments[G_SEGMENT_COUNT];
+
+        private:
+            ///
+            /// \fn     locate
+            /// \brief  Finds the segment and the slot in that segment holding the given ID.
+            ///
+            static inline void locate (const U32 a_id,
+                                       U32& a_segment,
+                                       U32& a_slot)
+            {
+                const std::uint64_t l_biased = static_cast<std::uint64_t>(a_id) + G_FIRST_SEGMENT;
+
+                U32 l_segment = 0;
+                while ((l_biased >> (l_segment + 7)) != 0)
+                    l_segment++;
+
+                a_segment = l_segment;
+                a_slot = static_cast<U32>(l_biased - (static_cast<std::uint64_t>(G_FIRST_SEGMENT) << l_segment));
+            }
+
+            ///
+            /// \fn     hash
+            /// \brief  Gets the 32-bit hash kept with a name in the index.
+            ///
+            static inline U32 hash (const String& a_name)
+            {
+                const std::uint64_t l_hash = std::hash<String> {}(a_name);
+                return static_cast<U32>(l_hash ^ (l_hash >> 32));
+            }
+
+            ///
+            /// \fn     find
+            /// \brief  Looks a name up in the given index.
+            ///
+            /// \return The name's ID plus one, or zero if it isn't in the index.
+            ///
+            std::uint64_t find (const Index& a_index,
+                                const String& a_name,
+                                const U32 a_hash) const
+            {
+                for (Size i = a_hash & a_index.m_mask; ; i = (i + 1) & a_index.m_mask)
+                {
+                    const std::uint64_t l_slot = a_index.m_slots[i].load(std::memory_order_acquire);
+                    if (l_slot == 0)
+                        return 0;
+
+                    if (static_cast<U32>(l_slot >> 32) == a_hash &&
+                        getString(static_cast<U32>(l_slot) - 1) == a_name)
+                        return static_cast<U32>(l_slot);
+                }
+            }
+
+            ///
+            /// \fn     place
+            /// \brief  Puts a name's slot into the given index. The lock must be held.
+            ///
+            static void place (Index& a_index,
+                               const std::uint64_t a_slot)
+            {
+                Size i = static_cast<U32>(a_slot >> 32) & a_index.m_mask;
+                while (a_index.m_slots[i].load(std::memory_order_relaxed) != 0)
+                    i = (i + 1) & a_index.m_mask;
+
+                a_index.m_slots[i].store(a_slot, std::memory_order_release);
+            }
+
+            ///
+            /// \fn     insert
+            /// \brief  Adds a name to the table. The lock must be held, and the name must be new.
+            ///
+            U32 insert (const String& a_name,
+                        const U32 a_hash)
+            {
+                const U32 l_id = static_cast<U32>(m_names.size());
+                m_names.push_back(a_name);
+
+                U32 l_segment = 0, l_slot = 0;
+                locate(l_id, l_segment, l_slot);
+
+                const String** lp_segment = m_segments[l_segment].load(std::memory_order_relaxed);
+                if (lp_segment == nullptr)
+                {
+                    lp_segment = new const String*[G_FIRST_SEGMENT << l_segment];
+                    m_segments[l_segment].store(lp_segment, std::memory_order_release);
+                }
+
+                // The slot is stored with release ordering, so a lookup which finds
+                // it also sees the string it points to.
+                lp_segment[l_slot] = &m_names.back();
+
+                // Keep the index no more than half full, so that probes stay short.
+                Index* lp_index = m_indices.back().get();
+                if ((m_names.size() * 2) > (lp_index->m_mask + 1))
+                {
+                    std::unique_ptr<Index> l_grown { new Index { (lp_index->m_mask + 1) * 2 } };
+                    for (Size i = 0; i <= lp_index->m_mask; ++i)
+                    {
+                        const std::uint64_t l_old = lp_index->m_slots[i].load(std::memory_order_relaxed);
+                        if (l_old != 0)
+                            place(*l_grown, l_old);
+                    }
+
+                    lp_index = l_grown.get();
+                    m_indices.push_back(std::move(l_grown));
+                    place(*lp_index, (static_cast<std::uint64_t>(a_hash) << 32) | (l_id + 1ull));
+                    m_index.store(lp_index, std::memory_order_release);
+                }
+                else
+                    place(*lp_index, (static_cast<std::uint64_t>(a_hash) << 32) | (l_id + 1ull));
+
+                return l_id;
+            }
+
+        public:
+            AtomTable ()
+            {
+                for (auto& l_segment : m_segments)
+                    l_segment.store(nullptr, std::memory_order_relaxed);
+
+                m_indices.emplace_back(new Index { G_FIRST_CAPACITY });
+                m_index.store(m_indices.back().get(), std::memory_order_relaxed);
+
+                // Intern the reserved names first, so their IDs are fixed.
+                insert("", hash(""));
+                insert("null", hash("null"));
+                insert("root", hash("root"));
+            }
+
+            ~AtomTable ()
+            {
+                for (auto& l_segment : m_segments)
+                    delete[] l_segment.load(std::memory_order_relaxed);
+            }
+
+        public:
+            U32 intern (const String& a_name)
+            {
+                const U32 l_hash = hash(a_name);
+
+                std::uint64_t l_found = find(*m_index.load(std::memory_order_acquire), a_name, l_hash);
+                if (l_found != 0)
+                    return static_cast<U32>(l_found - 1);
+
+                // Another thread may have added the name since it was looked for.
+                std::lock_guard<std::mutex> l_lock { m_mutex };
+
+                l_found = find(*m_index.load(std::memory_order_relaxed), a_name, l_hash);
+                if (l_found != 0)
+                    return static_cast<U32>(l_found - 1);
+
+                return insert(a_name, l_hash);
+            }
+
+            Boolean probe (const String& a_name,
+                           U32& a_id) const
+            {
+                const std::uint64_t l_found = find(*m_index.load(std::memory_order_acquire), a_name, hash(a_name));
+                if (l_found == 0)
+                    return false;
+
+                a_id = static_cast<U32>(l_found - 1);
+                return true;
+            }
+
+            const String& getString (const U32 a_id) const
+            {
+                U32 l_segment = 0, l_slot = 0;
+                locate(a_id, l_segment, l_slot);
+
+                return *m_segments[l_segment].load(std::memory_order_acquire)[l_slot];
+            }
+
+        };
+
+        ///
+        /// \fn     getAtomTable
+        /// \brief  Gets the global atom table.
+        ///
+        /// The table is created on first use, so that the "null" entries and keys,
+        /// which are constructed during static initialization, can intern their names.
+        ///
+        static AtomTable& getAtomTable ()
+        {
+            static AtomTable s_table;
+            return s_table;
+        }
+
+    }
+
+    Atom Atom::intern (const String &a_name)
+    {
+        return Atom { Private::getAtomTable().intern(a_name) };
+    }
+
+    Boolean Atom::probe (const String &a_name, Atom &a_atom)
+    {
+        U32 l_id = 0;
+        if (Private::getAtomTable().probe(a_name, l_id) == false)
+            return false;
+
+        a_atom = Atom { l_id };
+        return true;
+    }
+
+    const String& Atom::getString () const
+    {
+        return Private::getAtomTable().getString(m_id);
+    }
+
+}
@@ -0,0 +1,678 @@
+///
+/// \file   BatchLoader.cpp
+///
+
+#include <algorithm>
+#include <cstring>
+#include <Nelobin/Executor.hpp>
+#include <Nelobin/BatchLoader.hpp>
+
+#if defined(NELOBIN_IO_URING)
+# include <cerrno>
+# include <fcntl.h>
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+
+// The C library may be older than the kernel headers, and not know the system
+// calls by number. In that case, batches are always loaded on the executor.
+# if !defined(__NR_io_uring_setup) || !defined(__NR_io_uring_enter) || !defined(__NR_io_uring_register)
+#  undef NELOBIN_IO_URING
+# endif
+#endif
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        ///
+        /// \fn     finishBatchFile
+        /// \brief  Records the status of a file in a batch, emptying its registry if it failed to load.
+        ///
+        static void finishBatchFile (Registry& a_registry,
+                                     Status& a_status,
+                                     const Status a_result)
+        {
+            a_status = a_result;
+            if (a_result != Status::OK)
+                a_registry.clear();
+        }
+
+#if defined(NELOBIN_IO_URING)
+
+        ///
+        /// \class  Ring
+        /// \brief  A minimal io_uring instance, driven through the raw system calls.
+        ///
+        class Ring
+        {
+        private:
+            int             m_descriptor;   ///< The ring's file descriptor.
+            char*           mp_sqRing;      ///< The mapped submission ring.
+            Size            m_sqRingSize;   ///< The size of the submission ring's mapping.
+            char*           mp_cqRing;      ///< The mapped completion ring. May share the submission ring's mapping.
+            Size            m_cqRingSize;   ///< The size of the completion ring's mapping.
+            io_uring_sqe*   mp_sqes;        ///< The mapped submission queue entries.
+            Size            m_sqesSize;     ///< The size of the entries' mapping.
+            U32*            mp_sqHead;      ///< The submission ring's head, advanced by the kernel.
+            U32*            mp_sqTail;      ///< The submission ring's tail, advanced by us.
+            U32*            mp_sqArray;     ///< The submission ring's indices into the entries.
+            U32*            mp_cqHead;      ///< The completion ring's head, advanced by us.
+            U32*            mp_cqTail;      ///< The completion ring's tail, advanced by the kernel.
+            io_uring_cqe*   mp_cqes;        ///< The completion ring's entries.
+            U32             m_sqMask;       ///< Masks a submission ring position into an index.
+            U32             m_cqMask;       ///< Masks a completion ring position into an index.
+            U32             m_entries;      ///< The number of submission queue entries.
+            U32             m_queued;       ///< The number of entries queued, but not yet submitted.
+            U32             m_inFlight;     ///< The number of entries submitted, whose completions haven't been handled.
+
+        private:
+            ///
+            /// \fn     enter
+            /// \brief  Submits the queued entries, and waits for the given number of completions.
+            ///
+            Boolean enter (const U32 a_waitFor)
+            {
+                const unsigned l_flags = (a_waitFor > 0) ? IORING_ENTER_GETEVENTS : 0;
+
+                while (true)
+                {
+                    long l_result = syscall(__NR_io_uring_enter, m_descriptor, m_queued, a_waitFor,
+                                            l_flags, nullptr, 0);
+                    if (l_result >= 0)
+                    {
+                        m_queued -= static_cast<U32>(l_result);
+                        m_inFlight += static_cast<U32>(l_result);
+                        return true;
+                    }
+
+                    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                        return false;
+                }
+            }
+
+            ///
+            /// \fn     probe
+            /// \brief  Checks to see if the kernel supports each of the operations the loader uses.
+            ///
+            Boolean probe () const
+            {
+                const unsigned l_count = 256;
+                std::vector<char> l_storage(sizeof(io_uring_probe) + l_count * sizeof(io_uring_probe_op), 0);
+                io_uring_probe* lp_probe = reinterpret_cast<io_uring_probe*>(l_storage.data());
+
+                // Probing was added in 5.6, along with the operations we need.
+                if (syscall(__NR_io_uring_register, m_descriptor, IORING_REGISTER_PROBE, lp_probe, l_count) < 0)
+                    return false;
+
+                for (const U8 l_operation : { IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE })
+                {
+                    if (l_operation > lp_probe->last_op ||
+                        (lp_probe->ops[l_operation].flags & IO_URING_OP_SUPPORTED) == 0)
+                        return false;
+                }
+
+                return true;
+            }
+
+        public:
+            Ring () :
+                m_descriptor    { -1 },
+                mp_sqRing       { nullptr },
+                m_sqRingSize    { 0 },
+                mp_cqRing       { nullptr },
+                m_cqRingSize    { 0 },
+                mp_sqes         { nullptr },
+                m_sqesSize      { 0 },
+                mp_sqHead       { nullptr },
+                mp_sqTail       { nullptr },
+                mp_sqArray      { nullptr },
+                mp_cqHead       { nullptr },
+                mp_cqTail       { nullptr },
+                mp_cqes         { nullptr },
+                m_sqMask        { 0 },
+                m_cqMask        { 0 },
+                m_entries       { 0 },
+                m_queued        { 0 },
+                m_inFlight      { 0 }
+            {}
+
+            ~Ring ()
+            {
+                release();
+            }
+
+            Ring (const Ring&) = delete;
+            Ring& operator= (const Ring&) = delete;
+
+        public:
+            ///
+            /// \fn     setup
+            /// \brief  Creates the ring, with at least the given number of submission queue entries.
+            ///
+            /// \return True if the ring was created, and supports every operation the loader uses.
+            ///
+            Boolean setup (const U32 a_entries)
+            {
+                io_uring_params l_params;
+                std::memset(&l_params, 0, sizeof(l_params));
+
+                long l_descriptor = syscall(__NR_io_uring_setup, a_entries, &l_params);
+                if (l_descriptor < 0)
+                    return false;
+
+                m_descriptor = static_cast<int>(l_descriptor);
+
+                // Map the rings. Since 5.4, both rings share one mapping.
+                m_sqRingSize = l_params.sq_off.array + l_params.sq_entries * sizeof(U32);
+                m_cqRingSize = l_params.cq_off.cqes + l_params.cq_entries * sizeof(io_uring_cqe);
+                m_sqesSize = l_params.sq_entries * sizeof(io_uring_sqe);
+
+                const Boolean l_single = (l_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (l_single == true)
+                    m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+                void* lp_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                       m_descriptor, IORING_OFF_SQ_RING);
+                if (lp_sqRing == MAP_FAILED)
+                {
+                    release();
+                    return false;
+                }
+
+                mp_sqRing = static_cast<char*>(lp_sqRing);
+
+                if (l_single == true)
+                    mp_cqRing = mp_sqRing;
+                else
+                {
+                    void* lp_cqRing = mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                           m_descriptor, IORING_OFF_CQ_RING);
+                    if (lp_cqRing == MAP_FAILED)
+                    {
+                        release();
+                        return false;
+                    }
+
+                    mp_cqRing = static_cast<char*>(lp_cqRing);
+                }
+
+                void* lp_sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     m_descriptor, IORING_OFF_SQES);
+                if (lp_sqes == MAP_FAILED)
+                {
+                    release();
+                    return false;
+                }
+
+                mp_sqes = static_cast<io_uring_sqe*>(lp_sqes);
+
+                mp_sqHead = reinterpret_cast<U32*>(mp_sqRing + l_params.sq_off.head);
+                mp_sqTail = reinterpret_cast<U32*>(mp_sqRing + l_params.sq_off.tail);
+                mp_sqArray = reinterpret_cast<U32*>(mp_sqRing + l_params.sq_off.array);
+                m_sqMask = *reinterpret_cast<U32*>(mp_sqRing + l_params.sq_off.ring_mask);
+                mp_cqHead = reinterpret_cast<U32*>(mp_cqRing + l_params.cq_off.head);
+                mp_cqTail = reinterpret_cast<U32*>(mp_cqRing + l_params.cq_off.tail);
+                mp_cqes = reinterpret_cast<io_uring_cqe*>(mp_cqRing + l_params.cq_off.cqes);
+                m_cqMask = *reinterpret_cast<U32*>(mp_cqRing + l_params.cq_off.ring_mask);
+                m_entries = l_params.sq_entries;
+
+                if (probe() == false)
+                {
+                    release();
+                    return false;
+                }
+
+                return true;
+            }
+
+            ///
+            /// \fn     release
+            /// \brief  Unmaps and closes the ring.
+            ///
+            void release ()
+            {
+                if (mp_sqes != nullptr)
+                    munmap(mp_sqes, m_sqesSize);
+
+                if (mp_cqRing != nullptr && mp_cqRing != mp_sqRing)
+                    munmap(mp_cqRing, m_cqRingSize);
+
+                if (mp_sqRing != nullptr)
+                    munmap(mp_sqRing, m_sqRingSize);
+
+                if (m_descriptor >= 0)
+                    ::close(m_descriptor);
+
+                m_descriptor = -1;
+                mp_sqRing = mp_cqRing = nullptr;
+                mp_sqes = nullptr;
+                m_entries = m_queued = m_inFlight = 0;
+            }
+
+            ///
+            /// \fn     push
+            /// \brief  Queues a copy of the given submission queue entry.
+            ///
+            /// The caller must not have more entries in flight than the ring has room for.
+            ///
+            void push (const io_uring_sqe& a_sqe)
+            {
+                // Only the kernel moves the head, and only we move the tail.
+                const U32 l_tail = *mp_sqTail;
+                const U32 l_index = l_tail & m_sqMask;
+
+                mp_sqes[l_index] = a_sqe;
+                mp_sqArray[l_index] = l_index;
+                __atomic_store_n(mp_sqTail, l_tail + 1, __ATOMIC_RELEASE);
+                ++m_queued;
+            }
+
+            ///
+            /// \fn     complete
+            /// \brief  Submits the queued entries, and hands the given number of completions to a handler.
+            ///
+            /// The handler may queue more entries, and returns how many it queued, so
+            /// that their completions are waited for as well.
+            ///
+            /// \return False if the ring failed.
+            ///
+            template <typename Handler>
+            Boolean complete (U32 a_count,
+                              Handler&& a_handler)
+            {
+                while (a_count > 0)
+                {
+                    const U32 l_head = *mp_cqHead;
+                    if (l_head == __atomic_load_n(mp_cqTail, __ATOMIC_ACQUIRE))
+                    {
+                        if (enter(1) == false)
+                            return false;
+
+                        continue;
+                    }
+
+                    const io_uring_cqe l_cqe = mp_cqes[l_head & m_cqMask];
+                    __atomic_store_n(mp_cqHead, l_head + 1, __ATOMIC_RELEASE);
+                    --m_inFlight;
+
+                    a_count = a_count - 1 + a_handler(l_cqe);
+                }
+
+                return true;
+            }
+
+            ///
+            /// \fn     abandon
+            /// \brief  Withdraws the entries not yet submitted, then waits for those in flight.
+            ///
+            /// Withdrawn entries are handed to the first handler, so that it can do
+            /// by hand whatever must still be done, and completions to the second.
+            ///
+            /// \return False if entries may still be in flight, in which case the
+            ///         memory they point to must never be freed.
+            ///
+            template <typename Withdraw, typename Handler>
+            Boolean abandon (Withdraw&& a_withdraw,
+                             Handler&& a_handler)
+            {
+                // The kernel only takes entries from the submission ring when it is
+                // entered, so those past its head can still be taken back.
+                const U32 l_head = __atomic_load_n(mp_sqHead, __ATOMIC_ACQUIRE);
+                const U32 l_tail = *mp_sqTail;
+
+                for (U32 l_position = l_head; l_position != l_tail; ++l_position)
+                    a_withdraw(mp_sqes[mp_sqArray[l_position & m_sqMask]]);
+
+                __atomic_store_n(mp_sqTail, l_head, __ATOMIC_RELEASE);
+                m_queued = 0;
+
+                return complete(m_inFlight, [&a_handler] (const io_uring_cqe& a_cqe) -> U32
+                {
+                    a_handler(a_cqe);
+                    return 0;
+                });
+            }
+
+        public:
+            inline U32 getEntryCount () const { return m_entries; }
+
+        };
+
+        ///
+        /// \enum   RingOperations
+        /// \brief  The operations the loader submits, stored in the low bits of each entry's user data.
+        ///
+        enum RingOperations
+        {
+            RingOpen    = 0,
+            RingStat    = 1,
+            RingRead    = 2,
+            RingClose   = 3,
+            RingMask    = 3,
+            RingBits    = 2
+        };
+
+        ///
+        /// \struct RingFile
+        /// \brief  The state of a file being loaded through the ring.
+        ///
+        struct RingFile
+        {
+            String          m_filename;             ///< The file's name, which its open and size entries point to.
+            int             m_descriptor = -1;      ///< The file's descriptor, once it is opened.
+            Boolean         m_failed = false;       ///< Set if any operation on the file fails.
+            Boolean         m_parsed = false;       ///< Set once the file's contents are handed off to be parsed.
+            Boolean         m_closing = false;      ///< Set once the file's close is queued. The ring owns the descriptor from then on.
+            struct statx    m_stat;                 ///< Filled with the file's size.
+            ByteArray       m_bytes;                ///< The file's contents.
+            Size            m_read = 0;             ///< The number of bytes read so far.
+        };
+
+        ///
+        /// \fn     makeEntry
+        /// \brief  Prepares a submission queue entry for the given file and operation.
+        ///
+        static io_uring_sqe makeEntry (const U8 a_opcode,
+                                       const Size a_file,
+                                       const U8 a_operation)
+        {
+            io_uring_sqe l_sqe;
+            std::memset(&l_sqe, 0, sizeof(l_sqe));
+            l_sqe.opcode = a_opcode;
+            l_sqe.user_data = (static_cast<__u64>(a_file) << RingBits) | a_operation;
+            return l_sqe;
+        }
+
+        ///
+        /// \fn     makeRead
+        /// \brief  Prepares a read of the rest of the given file.
+        ///
+        static io_uring_sqe makeRead (const RingFile& a_state,
+                                      const Size a_file)
+        {
+            io_uring_sqe l_sqe = makeEntry(IORING_OP_READ, a_file, RingRead);
+            l_sqe.fd = a_state.m_descriptor;
+            l_sqe.addr = reinterpret_cast<__u64>(a_state.m_bytes.data() + a_state.m_read);
+            l_sqe.len = static_cast<U32>(std::min<Size>(a_state.m_bytes.size() - a_state.m_read, 0x7FFFF000));
+            l_sqe.off = a_state.m_read;
+            return l_sqe;
+        }
+
+        ///
+        /// \fn     makeClose
+        /// \brief  Prepares the closing of the given file.
+        ///
+        static io_uring_sqe makeClose (RingFile& a_state,
+                                       const Size a_file)
+        {
+            a_state.m_closing = true;
+
+            io_uring_sqe l_sqe = makeEntry(IORING_OP_CLOSE, a_file, RingClose);
+            l_sqe.fd = a_state.m_descriptor;
+            return l_sqe;
+        }
+
+        ///
+        /// \fn     readBatch
+        /// \brief  Reads a batch of files through the ring, starting a parse of each as soon as it is read.
+        ///
+        /// Each window of files takes two rounds: one which opens and sizes every
+        /// file, and one which reads and closes them.
+        ///
+        /// \param  a_parse     Called with the index and contents of each file read.
+        /// \param  a_retry     Set for each file which couldn't be read through the ring.
+        ///
+        /// \return False if the ring itself failed, and no more files should be submitted to it.
+        ///
+        template <typename Parse>
+        static Boolean readBatch (Ring& a_ring,
+                                  const std::vector<String>& a_filenames,
+                                  Parse&& a_parse,
+                                  std::vector<Boolean>& a_retry)
+        {
+            // Each file has at most two operations in flight at once.
+            const Size l_window = a_ring.getEntryCount() / 2;
+            std::vector<RingFile> l_files(l_window);
+
+            for (Size l_first = 0; l_first < a_filenames.size(); l_first += l_window)
+            {
+                const Size l_count = std::min(l_window, a_filenames.size() - l_first);
+                U32 l_submitted = 0;
+
+                for (Size i = 0; i < l_count; ++i)
+                    l_files[i] = RingFile { a_filenames[l_first + i] };
+
+                // Open and size every file in the window.
+                for (Size i = 0; i < l_count; ++i)
+                {
+                    const String& l_filename = l_files[i].m_filename;
+                    if (l_filename.empty() == true)
+                    {
+                        l_files[i].m_failed = true;
+                        continue;
+                    }
+
+                    io_uring_sqe l_open = makeEntry(IORING_OP_OPENAT, i, RingOpen);
+                    l_open.fd = AT_FDCWD;
+                    l_open.addr = reinterpret_cast<__u64>(l_filename.c_str());
+                    l_open.open_flags = O_RDONLY | O_CLOEXEC;
+                    a_ring.push(l_open);
+
+                    io_uring_sqe l_stat = makeEntry(IORING_OP_STATX, i, RingStat);
+                    l_stat.fd = AT_FDCWD;
+                    l_stat.addr = reinterpret_cast<__u64>(l_filename.c_str());
+                    l_stat.len = STATX_SIZE;
+                    l_stat.off = reinterpret_cast<__u64>(&l_files[i].m_stat);
+                    a_ring.push(l_stat);
+
+                    l_submitted += 2;
+                }
+
+                Boolean l_ok = a_ring.complete(l_submitted, [&] (const io_uring_cqe& a_cqe) -> U32
+                {
+                    RingFile& l_file = l_files[a_cqe.user_data >> RingBits];
+
+                    if (a_cqe.res < 0)
+                        l_file.m_failed = true;
+                    else if ((a_cqe.user_data & RingMask) == RingOpen)
+                        l_file.m_descriptor = a_cqe.res;
+
+                    return 0;
+                });
+
+                // Read every file which was opened and sized, then close it.
+                l_submitted = 0;
+                for (Size i = 0; i < l_count && l_ok == true; ++i)
+                {
+                    RingFile& l_file = l_files[i];
+                    if (l_file.m_descriptor < 0)
+                        continue;
+
+                    if (l_file.m_failed == false && l_file.m_stat.stx_size != 0)
+                    {
+                        l_file.m_bytes.resize(l_file.m_stat.stx_size);
+                        a_ring.push(makeRead(l_file, i));
+                    }
+                    else
+                    {
+                        if (l_file.m_failed == false)
+                        {
+                            a_parse(l_first + i, std::move(l_file.m_bytes));
+                            l_file.m_parsed = true;
+                        }
+
+                        a_ring.push(makeClose(l_file, i));
+                    }
+
+                    l_submitted++;
+                }
+
+                if (l_ok == true)
+                {
+                    l_ok = a_ring.complete(l_submitted, [&] (const io_uring_cqe& a_cqe) -> U32
+                    {
+                        const Size l_index = a_cqe.user_data >> RingBits;
+                        RingFile& l_file = l_files[l_index];
+
+                        if ((a_cqe.user_data & RingMask) == RingClose)
+                            return 0;
+
+                        if (a_cqe.res < 0)
+                            l_file.m_failed = true;
+                        else
+                        {
+                            // A read which returns nothing means that the file shrank since it was sized.
+                            l_file.m_read += a_cqe.res;
+                            if (a_cqe.res == 0)
+                                l_file.m_bytes.resize(l_file.m_read);
+
+                            if (l_file.m_read < l_file.m_bytes.size())
+                            {
+                                a_ring.push(makeRead(l_file, l_index));
+                                return 1;
+                            }
+
+                            a_parse(l_first + l_index, std::move(l_file.m_bytes));
+                            l_file.m_parsed = true;
+                        }
+
+                        a_ring.push(makeClose(l_file, l_index));
+                        return 1;
+                    });
+                }
+
+                // Files already handed off are being parsed, so only retry the others.
+                for (Size i = 0; i < l_count; ++i)
+                {
+                    if (l_files[i].m_parsed == false && (l_files[i].m_failed == true || l_ok == false))
+                        a_retry[l_first + i] = true;
+                }
+
+                if (l_ok == false)
+                {
+                    // Entries in flight point into the files' state. Take back those
+                    // not yet submitted, closing by hand any files they would have
+                    // closed, and wait for the rest to complete.
+                    const Boolean l_settled = a_ring.abandon([] (const io_uring_sqe& a_sqe)
+                    {
+                        if (a_sqe.opcode == IORING_OP_CLOSE)
+                            ::close(a_sqe.fd);
+                    },
+                    [&] (const io_uring_cqe& a_cqe)
+                    {
+                        if ((a_cqe.user_data & RingMask) == RingOpen && a_cqe.res >= 0)
+                            l_files[a_cqe.user_data >> RingBits].m_descriptor = a_cqe.res;
+                    });
+
+                    // Close whatever was opened, but never queued to be closed.
+                    for (Size i = 0; i < l_count; ++i)
+                    {
+                        if (l_files[i].m_descriptor >= 0 && l_files[i].m_closing == false)
+                            ::close(l_files[i].m_descriptor);
+                    }
+
+                    // If the kernel may still write into the files' state, it is
+                    // left to it, rather than freed.
+                    if (l_settled == false)
+                        new std::vector<RingFile>(std::move(l_files));
+
+                    // Files after this window haven't been submitted at all.
+                    std::fill(a_retry.begin() + l_first + l_count, a_retry.end(), true);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+#endif
+
+    }
+
+    std::vector<Status> BatchLoader::load (const std::vector<String> &a_filenames,
+                                           std::vector<std::unique_ptr<Registry>> &a_registries,
+                                           const Boolean a_useRing)
+    {
+        Executor& l_executor = Executor::getDefault();
+        std::vector<Status> l_statuses(a_filenames.size(), Status::OK);
+        std::vector<std::future<void>> l_tasks;
+
+        a_registries.clear();
+        a_registries.reserve(a_filenames.size());
+        for (Size i = 0; i < a_filenames.size(); ++i)
+            a_registries.push_back(std::make_unique<Registry>());
+
+        // Files which can't be read through the ring are loaded on the executor.
+        std::vector<Boolean> l_retry(a_filenames.size(), true);
+
+#if defined(NELOBIN_IO_URING)
+        if (a_useRing == true && a_filenames.empty() == false)
+        {
+            Private::Ring l_ring;
+            if (l_ring.setup(256) == true)
+            {
+                std::fill(l_retry.begin(), l_retry.end(), false);
+
+                auto l_parse = [&] (const Size a_index, ByteArray&& a_bytes)
+                {
+                    l_tasks.push_back(l_executor.submit(
+                        [&, a_index, l_bytes = std::move(a_bytes)] () mutable
+                        {
+                            Buffer l_buffer { std::move(l_bytes) };
+                            Status l_status = a_registries[a_index]->loadFromFileBuffer(l_buffer);
+                            if (l_status != Status::OK)
+                            {
+                                _Nelobin_Error("BatchLoader::load(): Error parsing registry file \"" <<
+                                               a_filenames[a_index] << "\".");
+                                l_status = Status::FileParseError;
+                            }
+
+                            Private::finishBatchFile(*a_registries[a_index], l_statuses[a_index], l_status);
+                        }
+                    ));
+                };
+
+                Private::readBatch(l_ring, a_filenames, l_parse, l_retry);
+            }
+        }
+#else
+        (void) a_useRing;
+#endif
+
+        for (Size i = 0; i < a_filenames.size(); ++i)
+        {
+            if (l_retry[i] == false)
+                continue;
+
+            l_tasks.push_back(l_executor.submit([&, i] ()
+            {
+                Private::finishBatchFile(*a_registries[i], l_statuses[i], a_registries[i]->loadFromFile(a_filenames[i]));
+            }));
+        }
+
+        for (auto& l_task : l_tasks)
+            l_task.wait();
+
+        return l_statuses;
+    }
+
+    Boolean BatchLoader::isRingAvailable ()
+    {
+#if defined(NELOBIN_IO_URING)
+        static const Boolean s_available = [] ()
+        {
+            Private::Ring l_ring;
+            return l_ring.setup(2);
+        }();
+
+        return s_available;
+#else
+        return false;
+#endif
+    }
+
+}
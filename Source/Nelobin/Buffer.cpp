@@ -5,27 +5,58 @@
 #include <fstream>
 #include <cstring>
 #include <Nelobin/Buffer.hpp>
+#include <Nelobin/Tracing.hpp>
 
 namespace Nelobin
 {
 
+    namespace Private
+    {
+
+        ///
+        /// \fn     loadBytes
+        /// \brief  Loads a value from bytes which may not be suitably aligned for it.
+        ///
+        template <typename T>
+        static inline T loadBytes (const char* ap_bytes)
+        {
+            T l_data;
+            std::memcpy(&l_data, ap_bytes, sizeof(T));
+            return l_data;
+        }
+
+    }
+
     bool Buffer::canRead (const Size a_size)
     {
-        return a_size + m_read <= m_bytes.size();
+        return m_trusted == true || a_size + m_read <= m_bytes.size();
     }
 
     Buffer::Buffer () :
-        m_read { 0 }
+        m_read      { 0 },
+        m_format    { Formats::Standard },
+        m_trusted   { false }
     {
 
     }
 
     Buffer::Buffer (const void *ap_data, const Size a_size) :
-        m_read { 0 }
+        m_read      { 0 },
+        m_format    { Formats::Standard },
+        m_trusted   { false }
     {
         writeRaw(ap_data, a_size);
     }
 
+    Buffer::Buffer (ByteArray &&a_bytes) :
+        m_bytes     { std::move(a_bytes) },
+        m_read      { 0 },
+        m_format    { Formats::Standard },
+        m_trusted   { false }
+    {
+
+    }
+
     Buffer::~Buffer ()
     {
         m_bytes.clear();
@@ -36,6 +67,9 @@ namespace Nelobin
         if (a_filename.empty() == true)
             return Status::NoName;
 
+        _Nelobin_Time(FileReadNanoseconds);
+        _Nelobin_Trace("read-file");
+
         // Load the file...
         std::fstream l_file { a_filename, std::ios::in |
                                           std::ios::binary |
@@ -51,12 +85,14 @@ namespace Nelobin
         // Clear the buffer.
         m_bytes.clear();
         m_read = 0;
+        m_trusted = false;
 
         // If the file is not empty, then load the bytes.
         if (l_size != 0)
         {
             m_bytes.resize(l_size);
             l_file.read(m_bytes.data(), l_size);
+            _Nelobin_Count(FileBytesRead, l_size);
         }
 
         // Don't forget to close the file stream before we leave.
@@ -70,6 +106,9 @@ namespace Nelobin
         if (a_filename.empty() == true)
             return Status::NoName;
 
+        _Nelobin_Time(FileWriteNanoseconds);
+        _Nelobin_Trace("write-file");
+
         // Open the file...
         std::fstream l_file { a_filename, std::ios::out |
                                           std::ios::binary };
@@ -78,6 +117,7 @@ namespace Nelobin
 
         // Place the bytes into the file.
         l_file.write(m_bytes.data(), m_bytes.size());
+        _Nelobin_Count(FileBytesWritten, m_bytes.size());
 
         // Close the file and exit.
         l_file.close();
@@ -87,7 +127,15 @@ namespace Nelobin
     void Buffer::clear ()
     {
         m_bytes.clear();
+        m_names.clear();
+        m_nameIndices.clear();
         m_read = 0;
+        m_trusted = false;
+    }
+
+    void Buffer::reserve (const Size a_size)
+    {
+        m_bytes.reserve(a_size);
     }
 
     Buffer& Buffer::writeRaw (const void *ap_data, const Size a_size)
@@ -95,10 +143,11 @@ namespace Nelobin
         // Check to see if the array is not null, and is populated.
         if (ap_data != nullptr && a_size > 0)
         {
-            // Expand the buffer and emplace the new data.
-            Size l_end = m_bytes.size();
-            m_bytes.resize(l_end + a_size);
-            std::memcpy(m_bytes.data() + l_end, ap_data, a_size);
+            // Append the new data. Unlike resizing first, this doesn't zero the
+            // new bytes before copying over them.
+            const char* lp_data = static_cast<const char*>(ap_data);
+            m_bytes.insert(m_bytes.end(), lp_data, lp_data + a_size);
+            m_trusted = false;
         }
 
         return *this;
@@ -113,6 +162,9 @@ namespace Nelobin
     template <>
     Buffer& Buffer::writeData (const S16& a_data)
     {
+        if (isCompact() == true)
+            return writeVarint(encodeZigzag(a_data));
+
         S16 l_swapped = swapBytes<S16>(a_data);
         return writeRaw(&l_swapped, sizeof(l_swapped));
     }
@@ -120,6 +172,9 @@ namespace Nelobin
     template <>
     Buffer& Buffer::writeData (const S32& a_data)
     {
+        if (isCompact() == true)
+            return writeVarint(encodeZigzag(a_data));
+
         S32 l_swapped = swapBytes<S32>(a_data);
         return writeRaw(&l_swapped, sizeof(l_swapped));
     }
@@ -133,6 +188,9 @@ namespace Nelobin
     template <>
     Buffer& Buffer::writeData (const U16& a_data)
     {
+        if (isCompact() == true)
+            return writeVarint(a_data);
+
         U16 l_swapped = swapBytes<U16>(a_data);
         return writeRaw(&l_swapped, sizeof(l_swapped));
     }
@@ -140,6 +198,9 @@ namespace Nelobin
     template <>
     Buffer& Buffer::writeData (const U32& a_data)
     {
+        if (isCompact() == true)
+            return writeVarint(a_data);
+
         U32 l_swapped = swapBytes<U32>(a_data);
         return writeRaw(&l_swapped, sizeof(l_swapped));
     }
@@ -167,6 +228,54 @@ namespace Nelobin
         return *this;
     }
 
+    template <>
+    Size Buffer::getDataSize (const S8&) const
+    {
+        return sizeof(S8);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const S16& a_data) const
+    {
+        return (isCompact() == true) ? getVarintSize(encodeZigzag(a_data)) : sizeof(S16);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const S32& a_data) const
+    {
+        return (isCompact() == true) ? getVarintSize(encodeZigzag(a_data)) : sizeof(S32);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const U8&) const
+    {
+        return sizeof(U8);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const U16& a_data) const
+    {
+        return (isCompact() == true) ? getVarintSize(a_data) : sizeof(U16);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const U32& a_data) const
+    {
+        return (isCompact() == true) ? getVarintSize(a_data) : sizeof(U32);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const Float&) const
+    {
+        return sizeof(U32);
+    }
+
+    template <>
+    Size Buffer::getDataSize (const String& a_data) const
+    {
+        return getDataSize<U32>(static_cast<U32>(a_data.size())) + a_data.size();
+    }
+
     Buffer& Buffer::readRaw (void *ap_data, const Size a_size)
     {
         if (ap_data != nullptr && a_size > 0 && canRead(a_size) == true)
@@ -183,7 +292,7 @@ namespace Nelobin
     {
         if (canRead(sizeof(a_data)) == true)
         {
-            a_data = *reinterpret_cast<S8*>(m_bytes.data() + m_read);
+            a_data = Private::loadBytes<S8>(m_bytes.data() + m_read);
             m_read += sizeof(a_data);
         }
 
@@ -193,10 +302,18 @@ namespace Nelobin
     template <>
     Buffer& Buffer::readData (S16& a_data)
     {
+        if (isCompact() == true)
+        {
+            U32 l_varint = 0;
+            readVarint(l_varint);
+            a_data = static_cast<S16>(decodeZigzag(l_varint));
+            return *this;
+        }
+
         if (canRead(sizeof(a_data)) == true)
         {
             a_data = swapBytes<S16>(
-                *reinterpret_cast<S16*>(m_bytes.data() + m_read)
+                Private::loadBytes<S16>(m_bytes.data() + m_read)
             );
 
             m_read += sizeof(a_data);
@@ -208,10 +325,18 @@ namespace Nelobin
     template <>
     Buffer& Buffer::readData (S32& a_data)
     {
+        if (isCompact() == true)
+        {
+            U32 l_varint = 0;
+            readVarint(l_varint);
+            a_data = decodeZigzag(l_varint);
+            return *this;
+        }
+
         if (canRead(sizeof(a_data)) == true)
         {
             a_data = swapBytes<S32>(
-                *reinterpret_cast<S32*>(m_bytes.data() + m_read)
+                Private::loadBytes<S32>(m_bytes.data() + m_read)
             );
 
             m_read += sizeof(a_data);
@@ -225,7 +350,7 @@ namespace Nelobin
     {
         if (canRead(sizeof(a_data)) == true)
         {
-            a_data = *reinterpret_cast<U8*>(m_bytes.data() + m_read);
+            a_data = Private::loadBytes<U8>(m_bytes.data() + m_read);
             m_read += sizeof(a_data);
         }
 
@@ -235,10 +360,18 @@ namespace Nelobin
     template <>
     Buffer& Buffer::readData (U16& a_data)
     {
+        if (isCompact() == true)
+        {
+            U32 l_varint = 0;
+            readVarint(l_varint);
+            a_data = static_cast<U16>(l_varint);
+            return *this;
+        }
+
         if (canRead(sizeof(a_data)) == true)
         {
             a_data = swapBytes<U16>(
-                *reinterpret_cast<U16*>(m_bytes.data() + m_read)
+                Private::loadBytes<U16>(m_bytes.data() + m_read)
             );
 
             m_read += sizeof(a_data);
@@ -250,10 +383,13 @@ namespace Nelobin
     template <>
     Buffer& Buffer::readData (U32& a_data)
     {
+        if (isCompact() == true)
+            return readVarint(a_data);
+
         if (canRead(sizeof(a_data)) == true)
         {
             a_data = swapBytes<U32>(
-                *reinterpret_cast<U32*>(m_bytes.data() + m_read)
+                Private::loadBytes<U32>(m_bytes.data() + m_read)
             );
 
             m_read += sizeof(a_data);
@@ -268,7 +404,7 @@ namespace Nelobin
         if (canRead(sizeof(a_data)) == true)
         {
             a_data = decodeFloat(
-                *reinterpret_cast<U32*>(m_bytes.data() + m_read)
+                Private::loadBytes<U32>(m_bytes.data() + m_read)
             );
 
             m_read += sizeof(a_data);
@@ -287,9 +423,17 @@ namespace Nelobin
         U32 l_length = 0;
         readData<U32>(l_length);
 
-        // If the string is not empty, then read it.
+        // If the string is not empty, then read it. A length running past the
+        // end of the buffer can only come from a corrupt file, so the read cursor
+        // is moved to the end and the string is left empty.
         if (l_length > 0)
         {
+            if (canRead(l_length) == false)
+            {
+                m_read = m_bytes.size();
+                return *this;
+            }
+
             a_data.append(
                 m_bytes.data() + m_read, l_length
             );
@@ -300,6 +444,216 @@ namespace Nelobin
         return *this;
     }
 
+    Buffer& Buffer::writeVarint (const U32 a_data)
+    {
+        // A 32-bit integer takes at most five bytes of seven bits each.
+        U8 l_bytes[5];
+        Size l_count = 0;
+        U32 l_data = a_data;
+
+        while (l_data >= 0x80)
+        {
+            l_bytes[l_count++] = static_cast<U8>(l_data | 0x80);
+            l_data >>= 7;
+        }
+
+        l_bytes[l_count++] = static_cast<U8>(l_data);
+        return writeRaw(l_bytes, l_count);
+    }
+
+    Buffer& Buffer::readVarint (U32 &a_data)
+    {
+        const U8* lp_bytes = reinterpret_cast<const U8*>(m_bytes.data()) + m_read;
+        const Size l_left = m_bytes.size() - m_read;
+
+        // Fast path: with five bytes available, no bounds checks are needed, and
+        // the decode is unrolled. Most values in a registry fit in one byte.
+        if (l_left >= 5)
+        {
+            U32 l_byte = lp_bytes[0];
+            U32 l_data = l_byte & 0x7F;
+            Size l_used = 1;
+
+            if (l_byte >= 0x80)
+            {
+                l_byte = lp_bytes[1]; l_data |= (l_byte & 0x7F) << 7;  l_used = 2;
+                if (l_byte >= 0x80)
+                {
+                    l_byte = lp_bytes[2]; l_data |= (l_byte & 0x7F) << 14; l_used = 3;
+                    if (l_byte >= 0x80)
+                    {
+                        l_byte = lp_bytes[3]; l_data |= (l_byte & 0x7F) << 21; l_used = 4;
+                        if (l_byte >= 0x80)
+                        {
+                            l_byte = lp_bytes[4]; l_data |= l_byte << 28; l_used = 5;
+                        }
+                    }
+                }
+            }
+
+            a_data = l_data;
+            m_read += l_used;
+            return *this;
+        }
+
+        // Slow path, near the end of the buffer. If the integer is truncated,
+        // the read cursor is moved to the end and the data is left untouched.
+        U32 l_data = 0;
+        for (Size i = 0; i < l_left; ++i)
+        {
+            l_data |= static_cast<U32>(lp_bytes[i] & 0x7F) << (7 * i);
+            if (lp_bytes[i] < 0x80)
+            {
+                a_data = l_data;
+                m_read += i + 1;
+                return *this;
+            }
+        }
+
+        m_read = m_bytes.size();
+        return *this;
+    }
+
+    Buffer& Buffer::writeHeader (const U32 a_header)
+    {
+        if (isCompact() == false)
+            return writeData<U32>(a_header);
+
+        U8 l_tag = 0;
+        if (a_header == G_ENTRY_HEADER)
+            l_tag = G_ENTRY_TAG;
+        else if (a_header == G_KEY_HEADER)
+            l_tag = G_KEY_TAG;
+        else if (a_header == G_COLUMNS_HEADER)
+            l_tag = G_COLUMNS_TAG;
+
+        return writeData<U8>(l_tag);
+    }
+
+    Buffer& Buffer::readHeader (U32 &a_header)
+    {
+        if (isCompact() == false)
+            return readData<U32>(a_header);
+
+        U8 l_tag = 0;
+        readData<U8>(l_tag);
+
+        switch (l_tag)
+        {
+        case G_ENTRY_TAG:   a_header = G_ENTRY_HEADER;  break;
+        case G_KEY_TAG:     a_header = G_KEY_HEADER;    break;
+        case G_COLUMNS_TAG: a_header = G_COLUMNS_HEADER; break;
+        default:            a_header = 0;               break;
+        }
+
+        return *this;
+    }
+
+    Size Buffer::getHeaderSize () const
+    {
+        return (isCompact() == true) ? sizeof(U8) : sizeof(U32);
+    }
+
+    void Buffer::addName (const Atom &a_name)
+    {
+        auto l_insert = m_nameIndices.emplace(a_name.getID(), static_cast<U32>(m_names.size()));
+        if (l_insert.second == true)
+            m_names.push_back(a_name);
+    }
+
+    Buffer& Buffer::writeNameTable ()
+    {
+        writeData<U32>(static_cast<U32>(m_names.size()));
+
+        for (const auto& l_name : m_names)
+            writeData<String>(l_name.getString());
+
+        return *this;
+    }
+
+    Buffer& Buffer::readNameTable ()
+    {
+        m_names.clear();
+        m_nameIndices.clear();
+
+        U32 l_count = 0;
+        readData<U32>(l_count);
+
+        // Every name takes at least one byte, so a count larger than the
+        // remaining bytes can only come from a corrupt table.
+        if (canRead(l_count) == false)
+            return *this;
+
+        String l_name = "";
+        m_names.reserve(l_count);
+        for (U32 i = 0; i < l_count; ++i)
+        {
+            readData<String>(l_name);
+            m_names.push_back(Atom::intern(l_name));
+        }
+
+        return *this;
+    }
+
+    Buffer& Buffer::writeName (const Atom &a_name)
+    {
+        if (hasNameTable() == false)
+            return writeData<String>(a_name.getString());
+
+        auto l_find = m_nameIndices.find(a_name.getID());
+        if (l_find == m_nameIndices.end())
+        {
+            _Nelobin_Error("Buffer::writeName(): Name \"" << a_name.getString() << "\" is not in the name table.");
+            return *this;
+        }
+
+        return writeVarint(l_find->second);
+    }
+
+    Size Buffer::getNameSize (const Atom &a_name) const
+    {
+        if (hasNameTable() == false)
+            return getDataSize<String>(a_name.getString());
+
+        auto l_find = m_nameIndices.find(a_name.getID());
+        return (l_find == m_nameIndices.end()) ? 0 : getVarintSize(l_find->second);
+    }
+
+    Buffer& Buffer::readName (Atom &a_name)
+    {
+        a_name = Atom {};
+
+        if (hasNameTable() == false)
+        {
+            String l_name = "";
+            readData<String>(l_name);
+
+            if (l_name.empty() == false)
+                a_name = Atom::intern(l_name);
+
+            return *this;
+        }
+
+        U32 l_index = 0;
+        Size l_before = m_read;
+        readVarint(l_index);
+
+        if (m_read != l_before && l_index < m_names.size())
+            a_name = m_names[l_index];
+
+        return *this;
+    }
+
+    void Buffer::setFormat (const U8 a_format)
+    {
+        m_format = a_format;
+    }
+
+    void Buffer::setTrusted (const Boolean a_trusted)
+    {
+        m_trusted = a_trusted;
+    }
+
     const char* Buffer::getData () const
     {
         return (m_bytes.empty()) ? nullptr : m_bytes.data();
@@ -310,6 +664,31 @@ namespace Nelobin
         return m_bytes.size();
     }
 
+    U8 Buffer::getFormat () const
+    {
+        return m_format;
+    }
+
+    bool Buffer::isCompact () const
+    {
+        return (m_format & Formats::Compact) != 0;
+    }
+
+    bool Buffer::hasNameTable () const
+    {
+        return (m_format & Formats::NameTable) != 0;
+    }
+
+    bool Buffer::isTrusted () const
+    {
+        return m_trusted;
+    }
+
+    Size Buffer::getRemaining () const
+    {
+        return m_bytes.size() - m_read;
+    }
+
     bool Buffer::isEmpty () const
     {
         return m_bytes.empty();
@@ -0,0 +1,70 @@
+///
+/// \file   Counters.cpp
+///
+
+#include <Nelobin/Counters.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        // The counters are defined whether or not they are enabled, so that the
+        // library links the same way either way.
+        Counter G_COUNTERS[CounterCount];
+
+    }
+
+    CounterSnapshot getCounters ()
+    {
+        CounterSnapshot l_snapshot;
+        for (Size i = 0; i < CounterCount; ++i)
+            l_snapshot.m_values[i] = Private::G_COUNTERS[i].m_value.load(std::memory_order_relaxed);
+
+        return l_snapshot;
+    }
+
+    void resetCounters ()
+    {
+        for (Size i = 0; i < CounterCount; ++i)
+            Private::G_COUNTERS[i].m_value.store(0, std::memory_order_relaxed);
+    }
+
+    const char* getCounterName (const Counters a_counter)
+    {
+        switch (a_counter)
+        {
+        case Counters::EntryLookups:            return "entry_lookups";
+        case Counters::EntryMisses:             return "entry_misses";
+        case Counters::KeyLookups:              return "key_lookups";
+        case Counters::KeyMisses:               return "key_misses";
+        case Counters::EntrySeeks:              return "entry_seeks";
+        case Counters::EntrySeekSteps:          return "entry_seek_steps";
+        case Counters::KeySeeks:                return "key_seeks";
+        case Counters::KeySeekSteps:            return "key_seek_steps";
+        case Counters::RecordsParsed:           return "records_parsed";
+        case Counters::BytesParsed:             return "bytes_parsed";
+        case Counters::KeyAllocations:          return "key_allocations";
+        case Counters::EntryAllocations:        return "entry_allocations";
+        case Counters::Loads:                   return "loads";
+        case Counters::LoadNanoseconds:         return "load_nanoseconds";
+        case Counters::Saves:                   return "saves";
+        case Counters::SaveNanoseconds:         return "save_nanoseconds";
+        case Counters::FileBytesRead:           return "file_bytes_read";
+        case Counters::FileReadNanoseconds:     return "file_read_nanoseconds";
+        case Counters::FileBytesWritten:        return "file_bytes_written";
+        case Counters::FileWriteNanoseconds:    return "file_write_nanoseconds";
+        default:                                return "unknown";
+        }
+    }
+
+    Boolean areCountersEnabled ()
+    {
+#if defined(NELOBIN_COUNTERS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+}
@@ -6,9 +6,14 @@
 /// we will need to define this in a CPP file.
 ///
 
-#include <Nelobin/EntryBase.hpp>
+#include <Nelobin/Key.hpp>
 
 namespace Nelobin
 {
-    EntryBase EntryBase::s_null { "null", Datatypes::Unknown };
+    EntryBase EntryBase::s_null { Atom::intern("null"), Datatypes::Unknown };
+
+    void EntryBase::notifyOwner ()
+    {
+        mp_owner->markDirty();
+    }
 }
@@ -2,10 +2,18 @@
 /// \file   Error.cpp
 ///
 
+#include <atomic>
 #include <Nelobin/Error.hpp>
 
 namespace Nelobin
 {
+    namespace Private
+    {
+
+        static std::atomic<DiagnosticHandler>   s_diagnosticHandler  { printDiagnostic };
+        static std::atomic<void*>               s_diagnosticUserData { nullptr };
+
+    }
 
     String stringifyStatus (const Status a_status)
     {
@@ -16,8 +24,34 @@ namespace Nelobin
         case Status::FileLoadError:     return "An error occured while loading the file.";
         case Status::FileSaveError:     return "An error occured while saving the file.";
         case Status::FileParseError:    return "An error occured while parsing the file.";
+        case Status::NotFound:          return "The key or entry requested was not found.";
+        case Status::TypeMismatch:      return "The entry requested is of another type.";
         default:                        return "An unknown error occured.";
         }
     }
 
+    void setDiagnosticHandler (DiagnosticHandler a_handler, void *ap_userData)
+    {
+        Private::s_diagnosticUserData.store(ap_userData, std::memory_order_relaxed);
+        Private::s_diagnosticHandler.store(a_handler, std::memory_order_release);
+    }
+
+    Boolean hasDiagnosticHandler ()
+    {
+        return Private::s_diagnosticHandler.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    void reportDiagnostic (const String &a_message)
+    {
+        DiagnosticHandler l_handler = Private::s_diagnosticHandler.load(std::memory_order_acquire);
+        if (l_handler != nullptr)
+            l_handler(a_message, Private::s_diagnosticUserData.load(std::memory_order_relaxed));
+    }
+
+    void printDiagnostic (const String &a_message, void *ap_userData)
+    {
+        (void) ap_userData;
+        std::cerr << a_message << std::endl;
+    }
+
 }
@@ -0,0 +1,73 @@
+///
+/// \file   Executor.cpp
+///
+
+#include <algorithm>
+#include <Nelobin/Executor.hpp>
+
+namespace Nelobin
+{
+
+    Executor::Executor (const Size a_workers) :
+        m_stopping  { false }
+    {
+        Size l_workers = a_workers;
+        if (l_workers == 0)
+            l_workers = std::max<Size>(1, std::thread::hardware_concurrency());
+
+        m_workers.reserve(l_workers);
+        for (Size i = 0; i < l_workers; ++i)
+            m_workers.emplace_back([this] () { work(); });
+    }
+
+    Executor::~Executor ()
+    {
+        {
+            std::lock_guard<std::mutex> l_lock { m_mutex };
+            m_stopping = true;
+        }
+
+        m_ready.notify_all();
+        for (auto& l_worker : m_workers)
+            l_worker.join();
+    }
+
+    void Executor::work ()
+    {
+        while (true)
+        {
+            std::function<void ()> l_task;
+
+            {
+                std::unique_lock<std::mutex> l_lock { m_mutex };
+                m_ready.wait(l_lock, [this] () { return m_stopping == true || m_tasks.empty() == false; });
+
+                // Drain the queue before stopping.
+                if (m_tasks.empty() == true)
+                    return;
+
+                l_task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+
+            l_task();
+        }
+    }
+
+    void Executor::post (std::function<void ()> a_task)
+    {
+        {
+            std::lock_guard<std::mutex> l_lock { m_mutex };
+            m_tasks.push_back(std::move(a_task));
+        }
+
+        m_ready.notify_one();
+    }
+
+    Executor& Executor::getDefault ()
+    {
+        static Executor s_executor;
+        return s_executor;
+    }
+
+}
@@ -0,0 +1,587 @@
+///
+/// \file   FrozenRegistry.cpp
+///
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <Nelobin/FrozenRegistry.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        /// Returned by lookups which find nothing.
+        static const U32 G_NOT_FOUND = static_cast<U32>(-1);
+
+        ///
+        /// \fn     getScalarBits
+        /// \brief  Gets the value of a scalar entry as a 32-bit pattern.
+        ///
+        /// Signed values are sign-extended, so that narrowing them back to their
+        /// own type restores them.
+        ///
+        static U32 getScalarBits (const EntryBase& a_entry)
+        {
+            #define _Nelobin_Scalar_Bits(a_type) \
+                return static_cast<U32>(static_cast<const Entry<a_type>&>(a_entry).get());
+
+            switch (a_entry.getAlias())
+            {
+            case Datatypes::SignedByte:         _Nelobin_Scalar_Bits(S8)
+            case Datatypes::SignedShort:        _Nelobin_Scalar_Bits(S16)
+            case Datatypes::SignedInteger:      _Nelobin_Scalar_Bits(S32)
+            case Datatypes::UnsignedByte:       _Nelobin_Scalar_Bits(U8)
+            case Datatypes::UnsignedShort:      _Nelobin_Scalar_Bits(U16)
+            case Datatypes::UnsignedInteger:    _Nelobin_Scalar_Bits(U32)
+            case Datatypes::FloatingPoint:
+            {
+                U32 l_bits = 0;
+                Float l_value = static_cast<const Entry<Float>&>(a_entry).get();
+                std::memcpy(&l_bits, &l_value, sizeof(l_bits));
+                return l_bits;
+            }
+            default:
+                return 0;
+            }
+
+            #undef _Nelobin_Scalar_Bits
+        }
+
+        ///
+        /// \class  StringPool
+        /// \brief  Gathers the strings of an image, storing each distinct string once.
+        ///
+        class StringPool
+        {
+        private:
+            std::vector<char>                   m_bytes;        ///< The null-terminated strings.
+            std::unordered_map<String, U32>     m_offsets;      ///< Maps strings to their offsets.
+
+        public:
+            U32 add (const String& a_string)
+            {
+                auto l_insert = m_offsets.emplace(a_string, static_cast<U32>(m_bytes.size()));
+                if (l_insert.second == true)
+                {
+                    m_bytes.insert(m_bytes.end(), a_string.begin(), a_string.end());
+                    m_bytes.push_back('\0');
+                }
+
+                return l_insert.first->second;
+            }
+
+            inline const std::vector<char>& getBytes () const { return m_bytes; }
+        };
+
+    }
+
+    FrozenKey::FrozenKey () :
+        mp_registry { nullptr },
+        m_node      { 0 }
+    {
+
+    }
+
+    FrozenKey::FrozenKey (const FrozenRegistry *ap_registry,
+                          const U32 a_node) :
+        mp_registry { ap_registry },
+        m_node      { a_node }
+    {
+
+    }
+
+    U32 FrozenKey::findEntry (const String &a_name, const U8 a_alias) const
+    {
+        U32 l_name = 0;
+        if (mp_registry == nullptr || mp_registry->findName(a_name, l_name) == false)
+            return Private::G_NOT_FOUND;
+
+        const FrozenRegistry::Node& l_node = mp_registry->mp_nodes[m_node];
+        const FrozenRegistry::Record* lp_entries = mp_registry->mp_entries + l_node.m_firstEntry;
+
+        for (U32 i = 0; i < l_node.m_entryCount; ++i)
+        {
+            if (lp_entries[i].m_name == l_name)
+                return (lp_entries[i].m_alias == a_alias) ? l_node.m_firstEntry + i : Private::G_NOT_FOUND;
+        }
+
+        return Private::G_NOT_FOUND;
+    }
+
+    U32 FrozenKey::findKey (const String &a_name, const U32 a_instance) const
+    {
+        U32 l_name = 0;
+        if (mp_registry == nullptr || mp_registry->findName(a_name, l_name) == false)
+            return Private::G_NOT_FOUND;
+
+        const FrozenRegistry::Node* lp_nodes = mp_registry->mp_nodes;
+        const FrozenRegistry::Node& l_node = lp_nodes[m_node];
+        const U32* lp_begin = mp_registry->mp_order + l_node.m_firstChild;
+        const U32* lp_end = lp_begin + l_node.m_childCount;
+
+        // The sorted subkey array lists this key's subkeys by name, then instance ID.
+        const U32* lp_find = std::lower_bound(lp_begin, lp_end, l_name,
+            [lp_nodes, a_instance] (const U32 a_child, const U32 a_name)
+            {
+                const FrozenRegistry::Node& l_child = lp_nodes[a_child];
+                return (l_child.m_name != a_name) ? (l_child.m_name < a_name) : (l_child.m_instance < a_instance);
+            });
+
+        if (lp_find == lp_end || lp_nodes[*lp_find].m_name != l_name || lp_nodes[*lp_find].m_instance != a_instance)
+            return Private::G_NOT_FOUND;
+
+        return *lp_find;
+    }
+
+    FrozenKey FrozenKey::getKey (const String &a_name, const U32 a_instance) const
+    {
+        U32 l_child = findKey(a_name, a_instance);
+        if (l_child == Private::G_NOT_FOUND)
+        {
+            _Nelobin_Error("FrozenKey::getKey(): In key \"" << getName() << "\":");
+            _Nelobin_Error("FrozenKey::getKey(): Key \"" << a_name << "\" (" << a_instance << ") not found.");
+            return FrozenKey {};
+        }
+
+        return FrozenKey { mp_registry, l_child };
+    }
+
+    FrozenKey FrozenKey::tryGetKey (const String &a_name, const U32 a_instance) const
+    {
+        U32 l_child = findKey(a_name, a_instance);
+        return (l_child == Private::G_NOT_FOUND) ? FrozenKey {} : FrozenKey { mp_registry, l_child };
+    }
+
+    FrozenKey FrozenKey::getKey (const Size a_index) const
+    {
+        if (a_index >= getKeyCount())
+        {
+            _Nelobin_Error("FrozenKey::getKey(): In key \"" << getName() << "\":");
+            _Nelobin_Error("FrozenKey::getKey(): Index " << a_index << " is out of range.");
+            return FrozenKey {};
+        }
+
+        return FrozenKey { mp_registry, mp_registry->mp_nodes[m_node].m_firstChild + static_cast<U32>(a_index) };
+    }
+
+    U32 FrozenKey::getInstanceCount (const String &a_name) const
+    {
+        U32 l_name = 0;
+        if (mp_registry == nullptr || mp_registry->findName(a_name, l_name) == false)
+            return 0;
+
+        const FrozenRegistry::Node* lp_nodes = mp_registry->mp_nodes;
+        const FrozenRegistry::Node& l_node = lp_nodes[m_node];
+        const U32* lp_begin = mp_registry->mp_order + l_node.m_firstChild;
+        const U32* lp_end = lp_begin + l_node.m_childCount;
+
+        // Subkeys with the same name are adjacent in the sorted subkey array.
+        const U32* lp_first = std::lower_bound(lp_begin, lp_end, l_name,
+            [lp_nodes] (const U32 a_child, const U32 a_name) { return lp_nodes[a_child].m_name < a_name; });
+        const U32* lp_last = std::upper_bound(lp_first, lp_end, l_name,
+            [lp_nodes] (const U32 a_name, const U32 a_child) { return a_name < lp_nodes[a_child].m_name; });
+
+        return static_cast<U32>(lp_last - lp_first);
+    }
+
+    String FrozenKey::getName () const
+    {
+        if (mp_registry == nullptr)
+            return "null";
+
+        const FrozenRegistry::Name& l_name = mp_registry->mp_names[mp_registry->mp_nodes[m_node].m_name];
+        return String { mp_registry->mp_pool + l_name.m_offset, l_name.m_length };
+    }
+
+    U32 FrozenKey::getInstanceID () const
+    {
+        return (mp_registry == nullptr) ? 0 : mp_registry->mp_nodes[m_node].m_instance;
+    }
+
+    Size FrozenKey::getEntryCount () const
+    {
+        return (mp_registry == nullptr) ? 0 : mp_registry->mp_nodes[m_node].m_entryCount;
+    }
+
+    Size FrozenKey::getKeyCount () const
+    {
+        return (mp_registry == nullptr) ? 0 : mp_registry->mp_nodes[m_node].m_childCount;
+    }
+
+    Boolean FrozenKey::isNull () const
+    {
+        return mp_registry == nullptr;
+    }
+
+    FrozenRegistry::FrozenRegistry () :
+        mp_image    { nullptr },
+        mp_header   { nullptr },
+        mp_nodes    { nullptr },
+        mp_entries  { nullptr },
+        mp_order    { nullptr },
+        mp_names    { nullptr },
+        mp_pool     { nullptr }
+    {
+
+    }
+
+    FrozenRegistry::FrozenRegistry (const Key &a_root) :
+        FrozenRegistry {}
+    {
+        freeze(a_root);
+    }
+
+    FrozenRegistry::FrozenRegistry (FrozenRegistry &&a_other) :
+        FrozenRegistry {}
+    {
+        *this = std::move(a_other);
+    }
+
+    FrozenRegistry& FrozenRegistry::operator= (FrozenRegistry &&a_other)
+    {
+        if (this == &a_other)
+            return *this;
+
+        // Moving a vector keeps its buffer, so the array pointers stay valid.
+        m_storage = std::move(a_other.m_storage);
+        mp_image = a_other.mp_image;
+        mp_header = a_other.mp_header;
+        mp_nodes = a_other.mp_nodes;
+        mp_entries = a_other.mp_entries;
+        mp_order = a_other.mp_order;
+        mp_names = a_other.mp_names;
+        mp_pool = a_other.mp_pool;
+
+        a_other.m_storage.clear();
+        a_other.mp_image = nullptr;
+        a_other.mp_header = nullptr;
+
+        return *this;
+    }
+
+    Status FrozenRegistry::bind (const void *ap_image, const Size a_size)
+    {
+        mp_image = nullptr;
+        mp_header = nullptr;
+
+        // The header must fit, and the arrays in the image must be aligned.
+        if (ap_image == nullptr || a_size < sizeof(Header) ||
+            reinterpret_cast<std::uintptr_t>(ap_image) % alignof(U32) != 0)
+            return Status::FileParseError;
+
+        const char* lp_image = static_cast<const char*>(ap_image);
+        const Header* lp_header = reinterpret_cast<const Header*>(lp_image);
+
+        if (lp_header->m_magic != G_FROZEN_HEADER ||
+            lp_header->m_version != G_FROZEN_VERSION ||
+            lp_header->m_size > a_size ||
+            lp_header->m_nodeCount == 0)
+            return Status::FileParseError;
+
+        // Check that each array lies within the image, and is aligned.
+        auto l_fits = [lp_header] (const U32 a_offset, const std::uint64_t a_length)
+        {
+            return a_offset % alignof(U32) == 0 &&
+                   a_offset >= sizeof(Header) &&
+                   static_cast<std::uint64_t>(a_offset) + a_length <= lp_header->m_size;
+        };
+
+        if (l_fits(lp_header->m_nodeOffset, static_cast<std::uint64_t>(lp_header->m_nodeCount) * sizeof(Node)) == false ||
+            l_fits(lp_header->m_entryOffset, static_cast<std::uint64_t>(lp_header->m_entryCount) * sizeof(Record)) == false ||
+            l_fits(lp_header->m_orderOffset, static_cast<std::uint64_t>(lp_header->m_nodeCount) * sizeof(U32)) == false ||
+            l_fits(lp_header->m_nameOffset, static_cast<std::uint64_t>(lp_header->m_nameCount) * sizeof(Name)) == false ||
+            l_fits(lp_header->m_poolOffset, lp_header->m_poolSize) == false)
+            return Status::FileParseError;
+
+        const Node* lp_nodes = reinterpret_cast<const Node*>(lp_image + lp_header->m_nodeOffset);
+        const Record* lp_entries = reinterpret_cast<const Record*>(lp_image + lp_header->m_entryOffset);
+        const U32* lp_order = reinterpret_cast<const U32*>(lp_image + lp_header->m_orderOffset);
+        const Name* lp_names = reinterpret_cast<const Name*>(lp_image + lp_header->m_nameOffset);
+        const char* lp_pool = lp_image + lp_header->m_poolOffset;
+
+        // Strings must lie within the pool, and be null-terminated.
+        auto l_inPool = [lp_header, lp_pool] (const U32 a_offset, const U32 a_length)
+        {
+            return static_cast<std::uint64_t>(a_offset) + a_length < lp_header->m_poolSize &&
+                   lp_pool[a_offset + a_length] == '\0';
+        };
+
+        for (U32 i = 0; i < lp_header->m_nameCount; ++i)
+        {
+            if (l_inPool(lp_names[i].m_offset, lp_names[i].m_length) == false)
+                return Status::FileParseError;
+        }
+
+        // Every key but the root must be the subkey of exactly one key, which
+        // comes before it, and the subkeys of each key must follow those of the
+        // key before it. This rules out cycles.
+        U32 l_nextChild = 1;
+        for (U32 i = 0; i < lp_header->m_nodeCount; ++i)
+        {
+            const Node& l_node = lp_nodes[i];
+
+            if ((i != 0 && i >= l_nextChild) ||
+                l_node.m_name >= lp_header->m_nameCount ||
+                static_cast<std::uint64_t>(l_node.m_firstEntry) + l_node.m_entryCount > lp_header->m_entryCount ||
+                l_node.m_firstChild != l_nextChild ||
+                static_cast<std::uint64_t>(l_node.m_firstChild) + l_node.m_childCount > lp_header->m_nodeCount)
+                return Status::FileParseError;
+
+            for (U32 c = 0; c < l_node.m_childCount; ++c)
+            {
+                U32 l_child = lp_order[l_node.m_firstChild + c];
+                if (l_child < l_node.m_firstChild || l_child >= l_node.m_firstChild + l_node.m_childCount)
+                    return Status::FileParseError;
+            }
+
+            l_nextChild += l_node.m_childCount;
+        }
+
+        if (l_nextChild != lp_header->m_nodeCount)
+            return Status::FileParseError;
+
+        for (U32 i = 0; i < lp_header->m_entryCount; ++i)
+        {
+            const Record& l_record = lp_entries[i];
+
+            if (l_record.m_name >= lp_header->m_nameCount ||
+                l_record.m_alias == Datatypes::Unknown || l_record.m_alias > Datatypes::StringLiteral)
+                return Status::FileParseError;
+
+            if (l_record.m_alias == Datatypes::StringLiteral && l_inPool(l_record.m_value, l_record.m_length) == false)
+                return Status::FileParseError;
+        }
+
+        mp_image = lp_image;
+        mp_header = lp_header;
+        mp_nodes = lp_nodes;
+        mp_entries = lp_entries;
+        mp_order = lp_order;
+        mp_names = lp_names;
+        mp_pool = lp_pool;
+
+        return Status::OK;
+    }
+
+    Boolean FrozenRegistry::findName (const String &a_name, U32 &a_index) const
+    {
+        if (mp_header == nullptr)
+            return false;
+
+        const Name* lp_begin = mp_names;
+        const Name* lp_end = mp_names + mp_header->m_nameCount;
+        const char* lp_pool = mp_pool;
+
+        const Name* lp_find = std::lower_bound(lp_begin, lp_end, a_name,
+            [lp_pool] (const Name& a_entry, const String& a_sought)
+            {
+                return a_sought.compare(0, String::npos, lp_pool + a_entry.m_offset, a_entry.m_length) > 0;
+            });
+
+        if (lp_find == lp_end || a_name.compare(0, String::npos, lp_pool + lp_find->m_offset, lp_find->m_length) != 0)
+            return false;
+
+        a_index = static_cast<U32>(lp_find - lp_begin);
+        return true;
+    }
+
+    Status FrozenRegistry::freeze (const Key &a_root)
+    {
+        // Lay the keys out breadth first, so that the subkeys of each key are
+        // adjacent, and come after it.
+        std::vector<const Key*> l_keys { &a_root };
+        Size l_entryCount = 0;
+
+        for (Size i = 0; i < l_keys.size(); ++i)
+        {
+            l_entryCount += l_keys[i]->m_entries.size();
+            for (const auto& l_child : l_keys[i]->m_keys)
+                l_keys.push_back(l_child.get());
+        }
+
+        // Gather the distinct names, then sort them, so they can be found by
+        // binary search.
+        std::unordered_map<U32, U32> l_nameIndices;
+        std::vector<Atom> l_names;
+
+        auto l_addName = [&l_nameIndices, &l_names] (const Atom& a_name)
+        {
+            if (l_nameIndices.emplace(a_name.getID(), 0).second == true)
+                l_names.push_back(a_name);
+        };
+
+        for (const Key* lp_key : l_keys)
+        {
+            l_addName(lp_key->m_name);
+            for (const auto& l_entry : lp_key->m_entries)
+                l_addName(l_entry->getAtom());
+        }
+
+        std::sort(l_names.begin(), l_names.end(), [] (const Atom& a_left, const Atom& a_right)
+        {
+            return a_left.getString() < a_right.getString();
+        });
+
+        Private::StringPool l_pool;
+        std::vector<Name> l_nameTable;
+        l_nameTable.reserve(l_names.size());
+
+        for (Size i = 0; i < l_names.size(); ++i)
+        {
+            l_nameIndices[l_names[i].getID()] = static_cast<U32>(i);
+            l_nameTable.push_back(Name { l_pool.add(l_names[i].getString()), static_cast<U32>(l_names[i].getString().size()) });
+        }
+
+        // Build the key and entry arrays.
+        std::vector<Node> l_nodes;
+        std::vector<Record> l_entries;
+        l_nodes.reserve(l_keys.size());
+        l_entries.reserve(l_entryCount);
+
+        U32 l_nextChild = 1;
+        for (const Key* lp_key : l_keys)
+        {
+            Node l_node;
+            l_node.m_name = l_nameIndices[lp_key->m_name.getID()];
+            l_node.m_instance = lp_key->m_instance;
+            l_node.m_firstEntry = static_cast<U32>(l_entries.size());
+            l_node.m_entryCount = static_cast<U32>(lp_key->m_entries.size());
+            l_node.m_firstChild = l_nextChild;
+            l_node.m_childCount = static_cast<U32>(lp_key->m_keys.size());
+            l_nodes.push_back(l_node);
+            l_nextChild += l_node.m_childCount;
+
+            for (const auto& l_entry : lp_key->m_entries)
+            {
+                Record l_record { l_nameIndices[l_entry->getAtom().getID()], l_entry->getAlias(), 0, 0 };
+
+                if (l_record.m_alias == Datatypes::StringLiteral)
+                {
+                    const String& l_string = static_cast<const Entry<String>&>(*l_entry).get();
+                    l_record.m_value = l_pool.add(l_string);
+                    l_record.m_length = static_cast<U32>(l_string.size());
+                }
+                else
+                    l_record.m_value = Private::getScalarBits(*l_entry);
+
+                l_entries.push_back(l_record);
+            }
+        }
+
+        // Sort each key's subkeys by name, then instance ID.
+        std::vector<U32> l_order(l_nodes.size(), 0);
+        for (const Node& l_node : l_nodes)
+        {
+            U32* lp_begin = l_order.data() + l_node.m_firstChild;
+            U32* lp_end = lp_begin + l_node.m_childCount;
+
+            for (U32 c = 0; c < l_node.m_childCount; ++c)
+                lp_begin[c] = l_node.m_firstChild + c;
+
+            std::sort(lp_begin, lp_end, [&l_nodes] (const U32 a_left, const U32 a_right)
+            {
+                const Node& l_left = l_nodes[a_left];
+                const Node& l_right = l_nodes[a_right];
+                return (l_left.m_name != l_right.m_name) ? (l_left.m_name < l_right.m_name) : (l_left.m_instance < l_right.m_instance);
+            });
+        }
+
+        // Lay out the image. Its offsets are 32 bits wide, so an image which
+        // would be 4 GiB or larger can't be built.
+        const Size l_nodeOffset = sizeof(Header);
+        const Size l_entryOffset = l_nodeOffset + l_nodes.size() * sizeof(Node);
+        const Size l_orderOffset = l_entryOffset + l_entries.size() * sizeof(Record);
+        const Size l_nameOffset = l_orderOffset + l_order.size() * sizeof(U32);
+        const Size l_poolOffset = l_nameOffset + l_nameTable.size() * sizeof(Name);
+        const Size l_size = l_poolOffset + l_pool.getBytes().size();
+
+        m_storage.clear();
+        m_storage.shrink_to_fit();
+        mp_image = nullptr;
+        mp_header = nullptr;
+
+        if (l_size > std::numeric_limits<U32>::max())
+        {
+            _Nelobin_Error("FrozenRegistry::freeze(): The registry is too large to freeze.");
+            return Status::FileSaveError;
+        }
+
+        Header l_header;
+        l_header.m_magic = G_FROZEN_HEADER;
+        l_header.m_version = G_FROZEN_VERSION;
+        l_header.m_nodeCount = static_cast<U32>(l_nodes.size());
+        l_header.m_nodeOffset = static_cast<U32>(l_nodeOffset);
+        l_header.m_entryCount = static_cast<U32>(l_entries.size());
+        l_header.m_entryOffset = static_cast<U32>(l_entryOffset);
+        l_header.m_orderOffset = static_cast<U32>(l_orderOffset);
+        l_header.m_nameCount = static_cast<U32>(l_nameTable.size());
+        l_header.m_nameOffset = static_cast<U32>(l_nameOffset);
+        l_header.m_poolSize = static_cast<U32>(l_pool.getBytes().size());
+        l_header.m_poolOffset = static_cast<U32>(l_poolOffset);
+        l_header.m_size = static_cast<U32>(l_size);
+
+        // Then copy the arrays into it.
+        m_storage.assign((l_size + sizeof(U32) - 1) / sizeof(U32), 0);
+        char* lp_image = reinterpret_cast<char*>(m_storage.data());
+
+        std::memcpy(lp_image, &l_header, sizeof(Header));
+        std::memcpy(lp_image + l_nodeOffset, l_nodes.data(), l_nodes.size() * sizeof(Node));
+        std::memcpy(lp_image + l_entryOffset, l_entries.data(), l_entries.size() * sizeof(Record));
+        std::memcpy(lp_image + l_orderOffset, l_order.data(), l_order.size() * sizeof(U32));
+        std::memcpy(lp_image + l_nameOffset, l_nameTable.data(), l_nameTable.size() * sizeof(Name));
+        std::memcpy(lp_image + l_poolOffset, l_pool.getBytes().data(), l_pool.getBytes().size());
+
+        Status l_status = bind(lp_image, l_size);
+        if (l_status != Status::OK)
+        {
+            _Nelobin_Error("FrozenRegistry::freeze(): The image built is not a valid frozen registry.");
+            m_storage.clear();
+            m_storage.shrink_to_fit();
+        }
+
+        return l_status;
+    }
+
+    Status FrozenRegistry::loadFromFile (const String &a_filename)
+    {
+        Registry l_registry;
+
+        Status l_status = l_registry.loadFromFile(a_filename);
+        if (l_status != Status::OK)
+            return l_status;
+
+        return freeze(l_registry);
+    }
+
+    Status FrozenRegistry::attach (const void *ap_image, const Size a_size)
+    {
+        // An image this registry owns would be freed below, once attached.
+        const char* lp_storage = reinterpret_cast<const char*>(m_storage.data());
+        if (ap_image != nullptr && m_storage.empty() == false &&
+            static_cast<const char*>(ap_image) >= lp_storage &&
+            static_cast<const char*>(ap_image) < lp_storage + m_storage.size() * sizeof(U32))
+        {
+            _Nelobin_Error("FrozenRegistry::attach(): The image given is this registry's own.");
+            return Status::FileParseError;
+        }
+
+        Status l_status = bind(ap_image, a_size);
+        if (l_status != Status::OK)
+        {
+            _Nelobin_Error("FrozenRegistry::attach(): The image given is not a valid frozen registry.");
+            return l_status;
+        }
+
+        m_storage.clear();
+        m_storage.shrink_to_fit();
+        return Status::OK;
+    }
+
+    FrozenKey FrozenRegistry::getRoot () const
+    {
+        return (mp_header == nullptr) ? FrozenKey {} : FrozenKey { this, 0 };
+    }
+
+}
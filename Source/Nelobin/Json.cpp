@@ -0,0 +1,830 @@
+///
+/// \file   Json.cpp
+///
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <Nelobin/Json.hpp>
+#include <Nelobin/Text.hpp>
+#include <Nelobin/Validator.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        /// The size at which written JSON is flushed, and in which it is read.
+        const Size G_JSON_CHUNK_SIZE = 64 * 1024;
+
+        /// The type written for strings which aren't valid UTF-8, as hexadecimal.
+        const U8 G_JSON_BYTES = 0xFF;
+
+        ///
+        /// \fn     getJsonTypeName
+        /// \brief  Gets the type annotation written for the given type alias.
+        ///
+        static const char* getJsonTypeName (const U8 a_alias)
+        {
+            switch (a_alias)
+            {
+            case Datatypes::SignedByte:         return "S8";
+            case Datatypes::SignedShort:        return "S16";
+            case Datatypes::SignedInteger:      return "S32";
+            case Datatypes::UnsignedByte:       return "U8";
+            case Datatypes::UnsignedShort:      return "U16";
+            case Datatypes::UnsignedInteger:    return "U32";
+            case Datatypes::FloatingPoint:      return "Float";
+            case Datatypes::StringLiteral:      return "String";
+            case G_JSON_BYTES:                  return "Bytes";
+            default:                            return nullptr;
+            }
+        }
+
+        ///
+        /// \fn     getJsonType
+        /// \brief  Gets the type alias named by a type annotation.
+        ///
+        /// \return The alias, or 'Datatypes::Unknown' if the annotation names no type.
+        ///
+        static U8 getJsonType (const char* ap_name)
+        {
+            static const U8 s_aliases[] = {
+                Datatypes::SignedByte, Datatypes::SignedShort, Datatypes::SignedInteger,
+                Datatypes::UnsignedByte, Datatypes::UnsignedShort, Datatypes::UnsignedInteger,
+                Datatypes::FloatingPoint, Datatypes::StringLiteral, G_JSON_BYTES
+            };
+
+            for (const U8 l_alias : s_aliases)
+            {
+                if (std::strcmp(ap_name, getJsonTypeName(l_alias)) == 0)
+                    return l_alias;
+            }
+
+            return Datatypes::Unknown;
+        }
+
+        ///
+        /// \fn     isValidUtf8
+        /// \brief  Checks that a string is well-formed UTF-8, without overlong forms or surrogates.
+        ///
+        static Boolean isValidUtf8 (const String& a_string)
+        {
+            const U8* lp_byte = reinterpret_cast<const U8*>(a_string.data());
+            const U8* lp_end = lp_byte + a_string.size();
+
+            while (lp_byte < lp_end)
+            {
+                const U8 l_lead = *lp_byte++;
+                if (l_lead < 0x80)
+                    continue;
+
+                Size l_length = 0;
+                U32 l_point = 0, l_minimum = 0;
+
+                if ((l_lead & 0xE0) == 0xC0)        { l_length = 1; l_point = l_lead & 0x1F; l_minimum = 0x80; }
+                else if ((l_lead & 0xF0) == 0xE0)   { l_length = 2; l_point = l_lead & 0x0F; l_minimum = 0x800; }
+                else if ((l_lead & 0xF8) == 0xF0)   { l_length = 3; l_point = l_lead & 0x07; l_minimum = 0x10000; }
+                else
+                    return false;
+
+                if (static_cast<Size>(lp_end - lp_byte) < l_length)
+                    return false;
+
+                for (Size i = 0; i < l_length; ++i)
+                {
+                    if ((lp_byte[i] & 0xC0) != 0x80)
+                        return false;
+
+                    l_point = (l_point << 6) | (lp_byte[i] & 0x3F);
+                }
+
+                if (l_point < l_minimum || l_point > 0x10FFFF || (l_point >= 0xD800 && l_point <= 0xDFFF))
+                    return false;
+
+                lp_byte += l_length;
+            }
+
+            return true;
+        }
+
+        ///
+        /// \fn     getHexDigit
+        /// \brief  Gets the value of a hexadecimal digit, or -1 if the character isn't one.
+        ///
+        static inline int getHexDigit (const int a_char)
+        {
+            if (a_char >= '0' && a_char <= '9') return a_char - '0';
+            if (a_char >= 'a' && a_char <= 'f') return a_char - 'a' + 10;
+            if (a_char >= 'A' && a_char <= 'F') return a_char - 'A' + 10;
+            return -1;
+        }
+
+        ///
+        /// \class  JsonWriter
+        /// \brief  Writes keys as JSON, into a chunk which is flushed to a stream as it fills.
+        ///
+        class JsonWriter
+        {
+        private:
+            std::ostream&   m_stream;       ///< The stream to write to.
+            String          m_text;         ///< The JSON not yet written to the stream.
+            Boolean         m_pretty;       ///< Is the JSON indented?
+            Boolean         m_good;         ///< Has everything gone well so far?
+
+        public:
+            JsonWriter (std::ostream& a_stream,
+                        const Boolean a_pretty) :
+                m_stream    { a_stream },
+                m_pretty    { a_pretty },
+                m_good      { true }
+            {
+                m_text.reserve(G_JSON_CHUNK_SIZE + 1024);
+            }
+
+        private:
+            void flush ()
+            {
+                if (m_good == true && m_text.empty() == false)
+                {
+                    m_stream.write(m_text.data(), static_cast<std::streamsize>(m_text.size()));
+                    m_good = m_stream.good();
+                }
+
+                m_text.clear();
+            }
+
+            void breakLine (const Size a_depth)
+            {
+                if (m_pretty == true)
+                {
+                    m_text.push_back('\n');
+                    m_text.append(a_depth * 4, ' ');
+                }
+
+                if (m_text.size() >= G_JSON_CHUNK_SIZE)
+                    flush();
+            }
+
+            void writeEscaped (const String& a_string)
+            {
+                static const char s_hex[] = "0123456789abcdef";
+
+                const char* lp_begin = a_string.data();
+                const char* lp_end = lp_begin + a_string.size();
+
+                // Copy over runs of characters which don't need escaping in one go.
+                for (const char* lp_char = lp_begin; lp_char != lp_end; ++lp_char)
+                {
+                    const U8 l_char = static_cast<U8>(*lp_char);
+                    if (l_char >= 0x20 && l_char != '"' && l_char != '\\')
+                        continue;
+
+                    m_text.append(lp_begin, lp_char);
+                    lp_begin = lp_char + 1;
+
+                    switch (l_char)
+                    {
+                    case '"':   m_text.append("\\\""); break;
+                    case '\\':  m_text.append("\\\\"); break;
+                    case '\n':  m_text.append("\\n"); break;
+                    case '\r':  m_text.append("\\r"); break;
+                    case '\t':  m_text.append("\\t"); break;
+                    case '\b':  m_text.append("\\b"); break;
+                    case '\f':  m_text.append("\\f"); break;
+                    default:
+                    {
+                        const char l_escape[6] = { '\\', 'u', '0', '0', s_hex[l_char >> 4], s_hex[l_char & 0xF] };
+                        m_text.append(l_escape, sizeof(l_escape));
+                    }
+                    }
+                }
+
+                m_text.append(lp_begin, lp_end);
+            }
+
+            void writeEntry (const EntryBase& a_entry)
+            {
+                U8 l_alias = a_entry.getAlias();
+                const String* lp_string = nullptr;
+
+                if (l_alias == Datatypes::StringLiteral)
+                {
+                    lp_string = &static_cast<const Entry<String>&>(a_entry).get();
+                    if (isValidUtf8(*lp_string) == false)
+                        l_alias = G_JSON_BYTES;
+                }
+
+                m_text.push_back('"');
+                writeEscaped(a_entry.getName());
+                m_text.push_back('@');
+                m_text.append(getJsonTypeName(l_alias));
+                m_text.append(m_pretty ? "\": " : "\":");
+
+                if (l_alias == Datatypes::FloatingPoint)
+                {
+                    const Float l_value = static_cast<const Entry<Float>&>(a_entry).get();
+
+                    if (std::isnan(l_value) == true)
+                        m_text.append("\"NaN\"");
+                    else if (std::isinf(l_value) == true)
+                        m_text.append(l_value < 0 ? "\"-Infinity\"" : "\"Infinity\"");
+                    else
+                        appendValue(m_text, l_value);
+                }
+                else if (l_alias == Datatypes::StringLiteral)
+                {
+                    m_text.push_back('"');
+                    writeEscaped(*lp_string);
+                    m_text.push_back('"');
+                }
+                else if (l_alias == G_JSON_BYTES)
+                {
+                    static const char s_hex[] = "0123456789abcdef";
+
+                    m_text.push_back('"');
+                    for (const char l_char : *lp_string)
+                    {
+                        m_text.push_back(s_hex[static_cast<U8>(l_char) >> 4]);
+                        m_text.push_back(s_hex[static_cast<U8>(l_char) & 0xF]);
+                    }
+                    m_text.push_back('"');
+                }
+                else
+                    appendEntry(m_text, a_entry);
+            }
+
+        public:
+            Boolean writeKey (const Key& a_key,
+                              const Size a_depth)
+            {
+                Boolean l_first = true;
+                m_text.push_back('{');
+
+                for (Size i = 0; i < a_key.getEntryCount(); ++i)
+                {
+                    const EntryBase& l_entry = a_key.getEntryBaseAt(i);
+                    if (getJsonTypeName(l_entry.getAlias()) == nullptr)
+                        continue;
+
+                    if (l_first == false)
+                        m_text.push_back(',');
+
+                    l_first = false;
+                    breakLine(a_depth + 1);
+
+                    if (isValidUtf8(l_entry.getName()) == false)
+                    {
+                        _Nelobin_Error("writeJson(): In key \"" << a_key.getName() << "\":");
+                        _Nelobin_Error("writeJson(): Entry \"" << l_entry.getName() << "\" isn't named in UTF-8.");
+                        return false;
+                    }
+
+                    writeEntry(l_entry);
+                }
+
+                // Subkeys which share a name, and sit next to one another, are
+                // written as an array.
+                Size l_run = 0;
+                for (Size i = 0; i < a_key.getKeyCount(); i += l_run)
+                {
+                    const Key& l_key = a_key.getKey(i);
+                    if (isValidUtf8(l_key.getName()) == false)
+                    {
+                        _Nelobin_Error("writeJson(): In key \"" << a_key.getName() << "\":");
+                        _Nelobin_Error("writeJson(): Subkey \"" << l_key.getName() << "\" isn't named in UTF-8.");
+                        return false;
+                    }
+
+                    l_run = 1;
+                    while (i + l_run < a_key.getKeyCount() &&
+                           a_key.getKey(i + l_run).getAtom() == l_key.getAtom())
+                        l_run++;
+
+                    if (l_first == false)
+                        m_text.push_back(',');
+
+                    l_first = false;
+                    breakLine(a_depth + 1);
+
+                    m_text.push_back('"');
+                    writeEscaped(l_key.getName());
+                    m_text.append(m_pretty ? "\": " : "\":");
+
+                    if (l_run == 1)
+                    {
+                        if (writeKey(l_key, a_depth + 1) == false)
+                            return false;
+
+                        continue;
+                    }
+
+                    m_text.push_back('[');
+                    for (Size j = i; j < i + l_run; ++j)
+                    {
+                        if (j != i)
+                            m_text.push_back(',');
+
+                        breakLine(a_depth + 2);
+                        if (writeKey(a_key.getKey(j), a_depth + 2) == false)
+                            return false;
+                    }
+
+                    breakLine(a_depth + 1);
+                    m_text.push_back(']');
+                }
+
+                if (l_first == false)
+                    breakLine(a_depth);
+
+                m_text.push_back('}');
+                return m_good;
+            }
+
+            Boolean finish ()
+            {
+                if (m_pretty == true)
+                    m_text.push_back('\n');
+
+                flush();
+                m_stream.flush();
+                return m_good == true && m_stream.good() == true;
+            }
+
+        };
+
+        ///
+        /// \class  JsonReader
+        /// \brief  Parses JSON from a stream, a chunk at a time, straight into a registry.
+        ///
+        class JsonReader
+        {
+        private:
+            std::istream&       m_stream;       ///< The stream to read from.
+            std::vector<char>   m_chunk;        ///< The chunk of the stream being parsed.
+            Size                m_position;     ///< The position of the next character in the chunk.
+            Size                m_size;         ///< The number of characters in the chunk.
+            Size                m_offset;       ///< The offset of the chunk in the stream.
+            String              m_name;         ///< The name of the member being parsed.
+            String              m_value;        ///< The string or number being parsed.
+
+        public:
+            explicit JsonReader (std::istream& a_stream) :
+                m_stream    { a_stream },
+                m_chunk     ( G_JSON_CHUNK_SIZE ),
+                m_position  { 0 },
+                m_size      { 0 },
+                m_offset    { 0 }
+            {
+
+            }
+
+        private:
+            Boolean fill ()
+            {
+                m_offset += m_size;
+                m_position = 0;
+                m_size = 0;
+
+                if (m_stream.good() == true)
+                {
+                    m_stream.read(m_chunk.data(), static_cast<std::streamsize>(m_chunk.size()));
+                    m_size = static_cast<Size>(m_stream.gcount());
+                }
+
+                return m_size > 0;
+            }
+
+            inline int peek ()
+            {
+                if (m_position == m_size && fill() == false)
+                    return EOF;
+
+                return static_cast<U8>(m_chunk[m_position]);
+            }
+
+            inline int get ()
+            {
+                const int l_char = peek();
+                if (l_char != EOF)
+                    m_position++;
+
+                return l_char;
+            }
+
+            int skipSpace ()
+            {
+                int l_char = peek();
+                while (l_char == ' ' || l_char == '\n' || l_char == '\r' || l_char == '\t')
+                {
+                    m_position++;
+                    l_char = peek();
+                }
+
+                return l_char;
+            }
+
+            Boolean fail (const char* ap_reason)
+            {
+                _Nelobin_Error("readJson(): " << ap_reason << ", at byte " << (m_offset + m_position) << ".");
+                (void) ap_reason;
+                return false;
+            }
+
+            Boolean readCodePoint (U32& a_point)
+            {
+                a_point = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const int l_digit = getHexDigit(get());
+                    if (l_digit < 0)
+                        return fail("Bad \\u escape");
+
+                    a_point = (a_point << 4) | static_cast<U32>(l_digit);
+                }
+
+                return true;
+            }
+
+            Boolean readEscape (String& a_string)
+            {
+                const int l_char = get();
+                switch (l_char)
+                {
+                case '"':   a_string.push_back('"'); return true;
+                case '\\':  a_string.push_back('\\'); return true;
+                case '/':   a_string.push_back('/'); return true;
+                case 'b':   a_string.push_back('\b'); return true;
+                case 'f':   a_string.push_back('\f'); return true;
+                case 'n':   a_string.push_back('\n'); return true;
+                case 'r':   a_string.push_back('\r'); return true;
+                case 't':   a_string.push_back('\t'); return true;
+                case 'u':   break;
+                default:    return fail("Bad escape in string");
+                }
+
+                // Code points outside the basic plane are escaped as surrogate pairs.
+                U32 l_point = 0;
+                if (readCodePoint(l_point) == false)
+                    return false;
+
+                if (l_point >= 0xDC00 && l_point <= 0xDFFF)
+                    return fail("Unpaired surrogate in string");
+                else if (l_point >= 0xD800 && l_point <= 0xDBFF)
+                {
+                    U32 l_low = 0;
+                    if (get() != '\\' || get() != 'u' || readCodePoint(l_low) == false ||
+                        l_low < 0xDC00 || l_low > 0xDFFF)
+                        return fail("Unpaired surrogate in string");
+
+                    l_point = 0x10000 + ((l_point - 0xD800) << 10) + (l_low - 0xDC00);
+                }
+
+                if (l_point < 0x80)
+                    a_string.push_back(static_cast<char>(l_point));
+                else if (l_point < 0x800)
+                {
+                    a_string.push_back(static_cast<char>(0xC0 | (l_point >> 6)));
+                    a_string.push_back(static_cast<char>(0x80 | (l_point & 0x3F)));
+                }
+                else if (l_point < 0x10000)
+                {
+                    a_string.push_back(static_cast<char>(0xE0 | (l_point >> 12)));
+                    a_string.push_back(static_cast<char>(0x80 | ((l_point >> 6) & 0x3F)));
+                    a_string.push_back(static_cast<char>(0x80 | (l_point & 0x3F)));
+                }
+                else
+                {
+                    a_string.push_back(static_cast<char>(0xF0 | (l_point >> 18)));
+                    a_string.push_back(static_cast<char>(0x80 | ((l_point >> 12) & 0x3F)));
+                    a_string.push_back(static_cast<char>(0x80 | ((l_point >> 6) & 0x3F)));
+                    a_string.push_back(static_cast<char>(0x80 | (l_point & 0x3F)));
+                }
+
+                return true;
+            }
+
+            Boolean readString (String& a_string)
+            {
+                a_string.clear();
+                if (get() != '"')
+                    return fail("Expected a string");
+
+                while (true)
+                {
+                    if (m_position == m_size && fill() == false)
+                        return fail("Unterminated string");
+
+                    // Copy over runs of characters which aren't escaped in one go.
+                    const char* lp_begin = m_chunk.data() + m_position;
+                    const char* lp_end = m_chunk.data() + m_size;
+                    const char* lp_char = lp_begin;
+
+                    while (lp_char != lp_end && *lp_char != '"' && *lp_char != '\\' &&
+                           static_cast<U8>(*lp_char) >= 0x20)
+                        lp_char++;
+
+                    a_string.append(lp_begin, lp_char);
+                    m_position += static_cast<Size>(lp_char - lp_begin);
+
+                    if (lp_char == lp_end)
+                        continue;
+
+                    m_position++;
+                    if (*lp_char == '"')
+                        return true;
+                    else if (*lp_char != '\\')
+                        return fail("Control character in string");
+                    else if (readEscape(a_string) == false)
+                        return false;
+                }
+            }
+
+            Boolean readNumber (String& a_number)
+            {
+                a_number.clear();
+
+                int l_char = peek();
+                while ((l_char >= '0' && l_char <= '9') || l_char == '-' || l_char == '+' ||
+                       l_char == '.' || l_char == 'e' || l_char == 'E')
+                {
+                    if (a_number.size() >= 64)
+                        return fail("Number too long");
+
+                    a_number.push_back(static_cast<char>(get()));
+                    l_char = peek();
+                }
+
+                if (a_number.empty() == true)
+                    return fail("Expected a number");
+
+                return true;
+            }
+
+            template <typename T>
+            Boolean readInteger (T& a_value)
+            {
+                if (readNumber(m_value) == false)
+                    return false;
+
+                long long l_value = 0;
+                const char* lp_end = m_value.data() + m_value.size();
+                auto l_result = std::from_chars(m_value.data(), lp_end, l_value);
+
+                if (l_result.ec != std::errc {} || l_result.ptr != lp_end ||
+                    l_value < static_cast<long long>(std::numeric_limits<T>::min()) ||
+                    l_value > static_cast<long long>(std::numeric_limits<T>::max()))
+                    return fail("Integer malformed, or out of range for its type");
+
+                a_value = static_cast<T>(l_value);
+                return true;
+            }
+
+            Boolean readFloat (Float& a_value)
+            {
+                if (peek() == '"')
+                {
+                    if (readString(m_value) == false)
+                        return false;
+
+                    if (m_value == "NaN")
+                        a_value = std::numeric_limits<Float>::quiet_NaN();
+                    else if (m_value == "Infinity")
+                        a_value = std::numeric_limits<Float>::infinity();
+                    else if (m_value == "-Infinity")
+                        a_value = -std::numeric_limits<Float>::infinity();
+                    else
+                        return fail("Expected a number, \"NaN\", \"Infinity\" or \"-Infinity\"");
+
+                    return true;
+                }
+
+                if (readNumber(m_value) == false)
+                    return false;
+
+                const char* lp_end = m_value.data() + m_value.size();
+                auto l_result = std::from_chars(m_value.data(), lp_end, a_value);
+
+                if (l_result.ec != std::errc {} || l_result.ptr != lp_end)
+                    return fail("Float malformed, or out of range");
+
+                return true;
+            }
+
+            Boolean readBytes (String& a_bytes)
+            {
+                if (readString(m_value) == false)
+                    return false;
+
+                if (m_value.size() % 2 != 0)
+                    return fail("Odd number of hexadecimal digits");
+
+                a_bytes.resize(m_value.size() / 2);
+                for (Size i = 0; i < a_bytes.size(); ++i)
+                {
+                    const int l_high = getHexDigit(m_value[i * 2]);
+                    const int l_low = getHexDigit(m_value[i * 2 + 1]);
+                    if (l_high < 0 || l_low < 0)
+                        return fail("Bad hexadecimal digit");
+
+                    a_bytes[i] = static_cast<char>((l_high << 4) | l_low);
+                }
+
+                return true;
+            }
+
+            template <typename T>
+            Boolean addEntry (Key& a_key, const Atom& a_name, const T& a_value)
+            {
+                const Size l_count = a_key.getEntryCount();
+                Entry<T>& l_entry = a_key.addEntry<T>(a_name);
+
+                if (a_key.getEntryCount() == l_count)
+                    return fail("Duplicate entry");
+
+                l_entry.set(a_value);
+                return true;
+            }
+
+            template <typename T>
+            Boolean readIntegerEntry (Key& a_key, const Atom& a_name)
+            {
+                T l_value = 0;
+                return readInteger(l_value) == true && addEntry<T>(a_key, a_name, l_value) == true;
+            }
+
+            Boolean readEntry (Key& a_key)
+            {
+                // The member's name ends with the entry's type, after an at sign.
+                const Size l_at = m_name.rfind('@');
+                if (l_at == String::npos || l_at == 0)
+                    return fail("Entry name missing, or not annotated with a type");
+
+                const U8 l_alias = getJsonType(m_name.c_str() + l_at + 1);
+                if (l_alias == Datatypes::Unknown)
+                    return fail("Unknown entry type");
+
+                m_name.resize(l_at);
+                const Atom l_name = Atom::intern(m_name);
+
+                switch (l_alias)
+                {
+                case Datatypes::SignedByte:         return readIntegerEntry<S8>(a_key, l_name);
+                case Datatypes::SignedShort:        return readIntegerEntry<S16>(a_key, l_name);
+                case Datatypes::SignedInteger:      return readIntegerEntry<S32>(a_key, l_name);
+                case Datatypes::UnsignedByte:       return readIntegerEntry<U8>(a_key, l_name);
+                case Datatypes::UnsignedShort:      return readIntegerEntry<U16>(a_key, l_name);
+                case Datatypes::UnsignedInteger:    return readIntegerEntry<U32>(a_key, l_name);
+                case Datatypes::FloatingPoint:
+                {
+                    Float l_value = 0.0f;
+                    return readFloat(l_value) == true && addEntry<Float>(a_key, l_name, l_value) == true;
+                }
+                case Datatypes::StringLiteral:
+                    return readString(m_value) == true && addEntry<String>(a_key, l_name, m_value) == true;
+                default:
+                {
+                    String l_bytes;
+                    return readBytes(l_bytes) == true && addEntry<String>(a_key, l_name, l_bytes) == true;
+                }
+                }
+            }
+
+            Boolean readSubkey (Key& a_key, const Atom& a_name, const U32 a_depth)
+            {
+                if (a_depth >= G_MAX_KEY_DEPTH)
+                    return fail("Keys nested too deeply");
+
+                const Size l_count = a_key.getKeyCount();
+                Key& l_key = a_key.addKey(a_name);
+
+                if (a_key.getKeyCount() == l_count)
+                    return fail("Bad key name");
+
+                return readKey(l_key, a_depth + 1);
+            }
+
+            Boolean readKey (Key& a_key, const U32 a_depth)
+            {
+                if (get() != '{')
+                    return fail("Expected an object");
+
+                int l_char = skipSpace();
+                if (l_char == '}')
+                {
+                    get();
+                    return true;
+                }
+
+                while (true)
+                {
+                    if (readString(m_name) == false)
+                        return false;
+
+                    if (skipSpace() != ':')
+                        return fail("Expected ':'");
+
+                    get();
+                    l_char = skipSpace();
+
+                    if (l_char == '{')
+                    {
+                        if (readSubkey(a_key, Atom::intern(m_name), a_depth) == false)
+                            return false;
+                    }
+                    else if (l_char == '[')
+                    {
+                        // An array holds instances of subkeys sharing the member's name.
+                        const Atom l_name = Atom::intern(m_name);
+
+                        get();
+                        l_char = skipSpace();
+
+                        while (l_char != ']')
+                        {
+                            if (l_char != '{')
+                                return fail("Expected an object in array");
+
+                            if (readSubkey(a_key, l_name, a_depth) == false)
+                                return false;
+
+                            l_char = skipSpace();
+                            if (l_char == ',')
+                            {
+                                get();
+                                l_char = skipSpace();
+                                if (l_char == ']')
+                                    return fail("Expected an object in array");
+                            }
+                            else if (l_char != ']')
+                                return fail("Expected ',' or ']'");
+                        }
+
+                        get();
+                    }
+                    else if (readEntry(a_key) == false)
+                        return false;
+
+                    l_char = skipSpace();
+                    if (l_char == '}')
+                    {
+                        get();
+                        return true;
+                    }
+                    else if (l_char != ',')
+                        return fail("Expected ',' or '}'");
+
+                    get();
+                    skipSpace();
+                }
+            }
+
+        public:
+            Boolean readDocument (Registry& a_registry)
+            {
+                if (skipSpace() != '{')
+                    return fail("Expected an object");
+
+                if (readKey(a_registry, 0) == false)
+                    return false;
+
+                if (skipSpace() != EOF)
+                    return fail("Unexpected text after the object");
+
+                return true;
+            }
+
+        };
+
+    }
+
+    Status writeJson (const Key &a_key, std::ostream &a_stream, const Boolean a_pretty)
+    {
+        Private::JsonWriter l_writer { a_stream, a_pretty };
+
+        if (l_writer.writeKey(a_key, 0) == false || l_writer.finish() == false)
+        {
+            _Nelobin_Error("writeJson(): Could not write the JSON.");
+            return Status::FileSaveError;
+        }
+
+        return Status::OK;
+    }
+
+    Status readJson (Registry &a_registry, std::istream &a_stream, const Boolean a_append)
+    {
+        if (a_append == false)
+            a_registry.clear();
+
+        Private::JsonReader l_reader { a_stream };
+        if (l_reader.readDocument(a_registry) == false)
+            return Status::FileParseError;
+
+        return Status::OK;
+    }
+
+}
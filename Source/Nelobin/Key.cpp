@@ -3,87 +3,347 @@
 ///
 
 #include <Nelobin/Key.hpp>
+#include <Nelobin/Tracing.hpp>
 
 namespace Nelobin
 {
+    namespace Private
+    {
+
+        const Size G_MIN_COLUMN_ROWS    = 4;        ///< The shortest run of subkeys written as columns.
+        const U8   G_COLUMN_PLAIN       = 0x00;     ///< Column values are written as-is.
+        const U8   G_COLUMN_DELTA       = 0x01;     ///< Integer column values are written as differences.
+
+        ///
+        /// \fn     isIntegerAlias
+        /// \brief  Checks whether a type alias names a 16- or 32-bit integer, which
+        ///         can be delta-encoded in a column.
+        ///
+        static inline Boolean isIntegerAlias (const U8 a_alias)
+        {
+            return a_alias == Datatypes::SignedShort   || a_alias == Datatypes::SignedInteger ||
+                   a_alias == Datatypes::UnsignedShort || a_alias == Datatypes::UnsignedInteger;
+        }
+
+        ///
+        /// \fn     getIntegerBits
+        /// \brief  Gets the value of an integer entry, sign-extended to 32 bits.
+        ///
+        static inline U32 getIntegerBits (const EntryBase& a_entry)
+        {
+            switch (a_entry.getAlias())
+            {
+            case Datatypes::SignedShort:
+                return static_cast<U32>(static_cast<S32>(static_cast<const Entry<S16>&>(a_entry).get()));
+            case Datatypes::SignedInteger:
+                return static_cast<U32>(static_cast<const Entry<S32>&>(a_entry).get());
+            case Datatypes::UnsignedShort:
+                return static_cast<const Entry<U16>&>(a_entry).get();
+            case Datatypes::UnsignedInteger:
+                return static_cast<const Entry<U32>&>(a_entry).get();
+            default:
+                return 0;
+            }
+        }
+
+        ///
+        /// \fn     setIntegerBits
+        /// \brief  Sets the value of an integer entry, truncated from 32 bits.
+        ///
+        static inline void setIntegerBits (EntryBase& a_entry,
+                                           const U32 a_bits)
+        {
+            switch (a_entry.getAlias())
+            {
+            case Datatypes::SignedShort:
+                static_cast<Entry<S16>&>(a_entry).set(static_cast<S16>(a_bits)); break;
+            case Datatypes::SignedInteger:
+                static_cast<Entry<S32>&>(a_entry).set(static_cast<S32>(a_bits)); break;
+            case Datatypes::UnsignedShort:
+                static_cast<Entry<U16>&>(a_entry).set(static_cast<U16>(a_bits)); break;
+            case Datatypes::UnsignedInteger:
+                static_cast<Entry<U32>&>(a_entry).set(a_bits); break;
+            default:
+                break;
+            }
+        }
+
+        ///
+        /// \fn     getPlainSize
+        /// \brief  Gets the size of an integer, written as-is to the given buffer.
+        ///
+        static inline Size getPlainSize (const Buffer& a_buffer,
+                                         const U8 a_alias,
+                                         const U32 a_bits)
+        {
+            switch (a_alias)
+            {
+            case Datatypes::SignedShort:
+                return a_buffer.getDataSize<S16>(static_cast<S16>(a_bits));
+            case Datatypes::SignedInteger:
+                return a_buffer.getDataSize<S32>(static_cast<S32>(a_bits));
+            case Datatypes::UnsignedShort:
+                return a_buffer.getDataSize<U16>(static_cast<U16>(a_bits));
+            default:
+                return a_buffer.getDataSize<U32>(a_bits);
+            }
+        }
+
+        // Cached Serialized Sizes
+        //
+        // A key's cached size is tagged with the format it was measured in, with
+        // a flag telling a measured size of zero from no size at all, and with a
+        // flag saying that the key's image was cached in that format, too.
+        const U64  G_SIZE_MEASURED      = 1ull << 63;
+        const U64  G_SIZE_IMAGED        = 1ull << 62;
+        const U32  G_SIZE_FORMAT_SHIFT  = 56;
+        const U64  G_SIZE_MASK          = (1ull << G_SIZE_FORMAT_SHIFT) - 1;
+
+        ///
+        /// \fn     getSizeTag
+        /// \brief  Gets the tag of a size measured in the given format.
+        ///
+        static inline U64 getSizeTag (const U8 a_format)
+        {
+            return G_SIZE_MEASURED | (static_cast<U64>(a_format & 0x3F) << G_SIZE_FORMAT_SHIFT);
+        }
+
+        ///
+        /// \struct KeyImage
+        /// \brief  A key's bytes, as last serialized.
+        ///
+        struct KeyImage
+        {
+            U8          m_format;       ///< The format the key was serialized in.
+            ByteArray   m_bytes;        ///< The bytes written.
+        };
+
+        /// The approximate size of the control block allocated for each shared subkey.
+        const Size G_SHARED_BLOCK_SIZE  = 3 * sizeof(void*);
+
+        /// The approximate size of the atom table's bookkeeping for each name: a
+        /// hash map node's link and cached hash, a bucket, and a slot mapping the ID back.
+        const Size G_ATOM_OVERHEAD      = 4 * sizeof(void*);
+
+        ///
+        /// \fn     getStringHeapSize
+        /// \brief  Gets the number of bytes a string has allocated, or zero if it is
+        ///         short enough to be stored within the string object itself.
+        ///
+        static inline Size getStringHeapSize (const String& a_string)
+        {
+            const auto l_data = reinterpret_cast<std::uintptr_t>(a_string.data());
+            const auto l_self = reinterpret_cast<std::uintptr_t>(&a_string);
+
+            if (l_data >= l_self && l_data < l_self + sizeof(String))
+                return 0;
+
+            return a_string.capacity() + 1;
+        }
+
+        ///
+        /// \fn     getNameSize
+        /// \brief  Gets the number of bytes the atom table takes to hold the given name.
+        ///
+        static inline Size getNameSize (const Atom& a_name)
+        {
+            return sizeof(String) + sizeof(U32) + getStringHeapSize(a_name.getString()) + G_ATOM_OVERHEAD;
+        }
+
+        ///
+        /// \fn     getEntryObjectSize
+        /// \brief  Gets the size of the entry object holding a value of the given type.
+        ///
+        static inline Size getEntryObjectSize (const U8 a_alias)
+        {
+            switch (a_alias)
+            {
+            case Datatypes::SignedByte:         return sizeof(Entry<S8>);
+            case Datatypes::SignedShort:        return sizeof(Entry<S16>);
+            case Datatypes::SignedInteger:      return sizeof(Entry<S32>);
+            case Datatypes::UnsignedByte:       return sizeof(Entry<U8>);
+            case Datatypes::UnsignedShort:      return sizeof(Entry<U16>);
+            case Datatypes::UnsignedInteger:    return sizeof(Entry<U32>);
+            case Datatypes::FloatingPoint:      return sizeof(Entry<Float>);
+            case Datatypes::StringLiteral:      return sizeof(Entry<String>);
+            default:                            return sizeof(EntryBase);
+            }
+        }
 
-    Key Key::s_null { "null" };
+        ///
+        /// \fn     isHeavierPath
+        /// \brief  Orders paths by the memory they take, heaviest first.
+        ///
+        static inline Boolean isHeavierPath (const PathUsage& a_left,
+                                             const PathUsage& a_right)
+        {
+            return a_left.m_usage.getTotal() > a_right.m_usage.getTotal();
+        }
+
+    }
+
+    thread_local Key Key::s_null { "null" };
+
+    Key& Key::getNull ()
+    {
+        s_null.clear();
+        return s_null;
+    }
 
     EntryBase::Iterator Key::seekEntry (const String &a_name)
     {
-        return std::find_if(m_entries.begin(), m_entries.end(),
-                            [&a_name] (const EntryBase::Ptr& a_entry)
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return m_entries.end();
+
+        return seekEntry(l_atom);
+    }
+
+    EntryBase::CIterator Key::cseekEntry (const String &a_name) const
+    {
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return m_entries.cend();
+
+        return cseekEntry(l_atom);
+    }
+
+    EntryBase::Iterator Key::seekEntry (const Atom &a_name)
+    {
+        auto l_find = std::find_if(m_entries.begin(), m_entries.end(),
+                                   [&a_name] (const EntryBase::Ptr& a_entry)
         {
-            return a_name == a_entry->getName();
+            return a_name == a_entry->getAtom();
         });
+
+        _Nelobin_Count(EntrySeeks, 1);
+        _Nelobin_Count(EntrySeekSteps, (l_find == m_entries.end()) ? m_entries.size() : l_find - m_entries.begin() + 1);
+        return l_find;
     }
 
-    EntryBase::CIterator Key::cseekEntry (const String &a_name) const
+    EntryBase::CIterator Key::cseekEntry (const Atom &a_name) const
     {
-        return std::find_if(m_entries.cbegin(), m_entries.cend(),
-                            [&a_name] (const EntryBase::Ptr& a_entry)
+        auto l_find = std::find_if(m_entries.cbegin(), m_entries.cend(),
+                                   [&a_name] (const EntryBase::Ptr& a_entry)
         {
-            return a_name == a_entry->getName();
+            return a_name == a_entry->getAtom();
         });
+
+        _Nelobin_Count(EntrySeeks, 1);
+        _Nelobin_Count(EntrySeekSteps, (l_find == m_entries.cend()) ? m_entries.size() : l_find - m_entries.cbegin() + 1);
+        return l_find;
     }
 
     Key::Iterator Key::seekKey (const String &a_name, const U32 a_instance)
     {
-        return std::find_if(m_keys.begin(), m_keys.end(),
-                            [&a_name, &a_instance] (const Key::Ptr& a_key)
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return m_keys.end();
+
+        return seekKey(l_atom, a_instance);
+    }
+
+    Key::CIterator Key::cseekKey (const String &a_name, const U32 a_instance) const
+    {
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return m_keys.cend();
+
+        return cseekKey(l_atom, a_instance);
+    }
+
+    Key::Iterator Key::seekKey (const Atom &a_name, const U32 a_instance)
+    {
+        auto l_find = std::find_if(m_keys.begin(), m_keys.end(),
+                                   [&a_name, &a_instance] (const Key::Ptr& a_key)
         {
-            return a_name == a_key->getName() &&
-                   a_instance == a_key->getInstanceID();
+            return a_name == a_key->m_name &&
+                   a_instance == a_key->m_instance;
         });
+
+        _Nelobin_Count(KeySeeks, 1);
+        _Nelobin_Count(KeySeekSteps, (l_find == m_keys.end()) ? m_keys.size() : l_find - m_keys.begin() + 1);
+        return l_find;
     }
 
-    Key::CIterator Key::cseekKey (const String &a_name, const U32 a_instance) const
+    Key::CIterator Key::cseekKey (const Atom &a_name, const U32 a_instance) const
     {
-        return std::find_if(m_keys.cbegin(), m_keys.cend(),
-                            [&a_name, &a_instance] (const Key::Ptr& a_key)
+        auto l_find = std::find_if(m_keys.cbegin(), m_keys.cend(),
+                                   [&a_name, &a_instance] (const Key::Ptr& a_key)
         {
-            return a_name == a_key->getName() &&
-                   a_instance == a_key->getInstanceID();
+            return a_name == a_key->m_name &&
+                   a_instance == a_key->m_instance;
         });
+
+        _Nelobin_Count(KeySeeks, 1);
+        _Nelobin_Count(KeySeekSteps, (l_find == m_keys.cend()) ? m_keys.size() : l_find - m_keys.cbegin() + 1);
+        return l_find;
     }
 
-    Key::Iterator Key::seekKeyFrom (const String &a_name, Key::Iterator a_from)
+    Key::Iterator Key::seekKeyFrom (const Atom &a_name, Key::Iterator a_from)
     {
         if (a_from >= m_keys.end())
             return m_keys.end();
 
-        return std::find_if(a_from, m_keys.end(),
-                            [&a_name] (const Key::Ptr& a_key)
+        auto l_find = std::find_if(a_from, m_keys.end(),
+                                   [&a_name] (const Key::Ptr& a_key)
         {
-            return a_name == a_key->getName();
+            return a_name == a_key->m_name;
         });
+
+        _Nelobin_Count(KeySeeks, 1);
+        _Nelobin_Count(KeySeekSteps, (l_find == m_keys.end()) ? m_keys.end() - a_from : l_find - a_from + 1);
+        return l_find;
     }
 
-    Key::CIterator Key::cseekKeyFrom (const String &a_name, Key::CIterator a_from) const
+    Key::CIterator Key::cseekKeyFrom (const Atom &a_name, Key::CIterator a_from) const
     {
         if (a_from >= m_keys.cend())
             return m_keys.cend();
 
-        return std::find_if(a_from, m_keys.cend(),
-                            [&a_name] (const Key::Ptr& a_key)
+        auto l_find = std::find_if(a_from, m_keys.cend(),
+                                   [&a_name] (const Key::Ptr& a_key)
         {
-            return a_name == a_key->getName();
+            return a_name == a_key->m_name;
         });
+
+        _Nelobin_Count(KeySeeks, 1);
+        _Nelobin_Count(KeySeekSteps, (l_find == m_keys.cend()) ? m_keys.cend() - a_from : l_find - a_from + 1);
+        return l_find;
+    }
+
+    Key& Key::detach (Key::Ptr &a_slot)
+    {
+        if (a_slot.use_count() > 1)
+        {
+            a_slot = Key::Ptr { new Key(*a_slot, this) };
+            markChanged();
+        }
+        else
+        {
+            // 'use_count' is only a relaxed load. Whoever dropped the last other
+            // reference did so with a release, so this fence orders their reads
+            // of the subkey before our writes to it.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            a_slot->mp_parent = this;
+        }
+
+        return *a_slot;
     }
 
     Boolean Key::deserializeEntry (Buffer &a_buffer)
     {
         // Get the entry's name and type alias
-        String l_name = "";
+        Atom l_name;
         U8 l_alias = 0;
 
-        a_buffer.readData<String>(l_name)
+        a_buffer.readName(l_name)
                 .readData<U8>(l_alias);
 
         // Make sure that we found them.
-        if (l_name.empty() == true)
+        if (l_name.isEmpty() == true)
         {
-            _Nelobin_Error("Key::deserializeEntry(): In key \"" + m_name + "\":");
+            _Nelobin_Error("Key::deserializeEntry(): In key \"" + getName() + "\":");
             _Nelobin_Error("Key::deserializeEntry(): Parse error - No entry name found.");
             return false;
         }
@@ -110,7 +370,7 @@ namespace Nelobin
         case Datatypes::StringLiteral:      _Nelobin_Deserialize_Entry(String)
         case Datatypes::Unknown:
         default:
-            _Nelobin_Error("Key::deserializeEntry(): In key \"" + m_name + "\":");
+            _Nelobin_Error("Key::deserializeEntry(): In key \"" + getName() + "\":");
             _Nelobin_Error("Key::deserializeEntry(): Parse error - Entry type alias not recognized.");
             return false;
         }
@@ -120,17 +380,20 @@ namespace Nelobin
 
     Boolean Key::deserializeKey (Buffer &a_buffer)
     {
+        _Nelobin_TraceKey("deserialize-key");
+
         // Get the key's name and expected number of entities.
-        String l_name = "";
+        Atom l_name;
         U32 l_entityCount = 0;
 
-        a_buffer.readData<String>(l_name)
+        a_buffer.readName(l_name)
                 .readData<U32>(l_entityCount);
+        _Nelobin_TraceDetail(l_name);
 
         // Check to see if a name was provided.
-        if (l_name.empty() == true)
+        if (l_name.isEmpty() == true)
         {
-            _Nelobin_Error("Key::deserializeKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::deserializeKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::deserializeKey(): Parse error - No subkey name found.");
             return false;
         }
@@ -139,7 +402,7 @@ namespace Nelobin
         Key& l_key = addKey(l_name);
         if (l_key.isNull() == true)
         {
-            _Nelobin_Error("Key::deserializeKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::deserializeKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::deserializeKey(): Parse error - Subkey name reserved.");
             return false;
         }
@@ -149,7 +412,7 @@ namespace Nelobin
         {
             if (l_key.deserializeNext(a_buffer) == false)
             {
-                _Nelobin_Error("Key::deserializeKey(): In key \"" << m_name << "\":");
+                _Nelobin_Error("Key::deserializeKey(): In key \"" << getName() << "\":");
                 _Nelobin_Error("Key::deserializeKey(): Parse error - Could not parse subkey.");
                 return false;
             }
@@ -158,6 +421,144 @@ namespace Nelobin
         return true;
     }
 
+    Boolean Key::deserializeColumns (Buffer &a_buffer)
+    {
+        _Nelobin_TraceKey("deserialize-columns");
+
+        // Get the name shared by the block's subkeys, and the block's dimensions.
+        Atom l_name;
+        U32 l_rowCount = 0;
+        U32 l_columnCount = 0;
+
+        a_buffer.readName(l_name)
+                .readData<U32>(l_rowCount)
+                .readData<U32>(l_columnCount);
+        _Nelobin_TraceDetail(l_name);
+
+        if (l_name.isEmpty() == true || l_name.isReserved() == true)
+        {
+            _Nelobin_Error("Key::deserializeColumns(): In key \"" << getName() << "\":");
+            _Nelobin_Error("Key::deserializeColumns(): Parse error - Invalid subkey name found.");
+            return false;
+        }
+
+        // Every value takes at least one byte, so larger dimensions than the bytes
+        // left in the buffer can only come from a corrupt block.
+        if (l_columnCount == 0 ||
+            l_rowCount > a_buffer.getRemaining() / l_columnCount)
+        {
+            _Nelobin_Error("Key::deserializeColumns(): In key \"" << getName() << "\":");
+            _Nelobin_Error("Key::deserializeColumns(): Parse error - Invalid column dimensions.");
+            return false;
+        }
+
+        // Read the schema.
+        std::vector<Atom> l_names(l_columnCount);
+        std::vector<U8> l_aliases(l_columnCount, Datatypes::Unknown);
+        std::vector<U8> l_encodings(l_columnCount, Private::G_COLUMN_PLAIN);
+
+        for (U32 c = 0; c < l_columnCount; ++c)
+        {
+            a_buffer.readName(l_names[c])
+                    .readData<U8>(l_aliases[c])
+                    .readData<U8>(l_encodings[c]);
+
+            if (l_names[c].isEmpty() == true)
+            {
+                _Nelobin_Error("Key::deserializeColumns(): In key \"" << getName() << "\":");
+                _Nelobin_Error("Key::deserializeColumns(): Parse error - No column name found.");
+                return false;
+            }
+        }
+
+        // Build the rows as ordinary subkeys. Their instance IDs are handed out
+        // in one go, rather than re-counted by 'addKey' for every row.
+        U32 l_instance = getInstanceCount(l_name);
+        Size l_firstRow = m_keys.size();
+        m_keys.reserve(l_firstRow + l_rowCount);
+
+        #define _Nelobin_Column_Entry(a_type) \
+            l_row->m_entries.emplace_back(new Entry<a_type>(l_names[c])); \
+            l_row->m_entries.back()->mp_owner = l_row.get(); break;
+
+        for (U32 r = 0; r < l_rowCount; ++r)
+        {
+            Key::Ptr l_row { new Key(l_name, l_instance + r, this) };
+            l_row->m_entries.reserve(l_columnCount);
+
+            for (U32 c = 0; c < l_columnCount; ++c)
+            {
+                switch (l_aliases[c])
+                {
+                case Datatypes::SignedByte:         _Nelobin_Column_Entry(S8)
+                case Datatypes::SignedShort:        _Nelobin_Column_Entry(S16)
+                case Datatypes::SignedInteger:      _Nelobin_Column_Entry(S32)
+                case Datatypes::UnsignedByte:       _Nelobin_Column_Entry(U8)
+                case Datatypes::UnsignedShort:      _Nelobin_Column_Entry(U16)
+                case Datatypes::UnsignedInteger:    _Nelobin_Column_Entry(U32)
+                case Datatypes::FloatingPoint:      _Nelobin_Column_Entry(Float)
+                case Datatypes::StringLiteral:      _Nelobin_Column_Entry(String)
+                default:
+                    _Nelobin_Error("Key::deserializeColumns(): In key \"" << getName() << "\":");
+                    _Nelobin_Error("Key::deserializeColumns(): Parse error - Column type alias not recognized.");
+                    m_keys.resize(l_firstRow);
+                    return false;
+                }
+            }
+
+            m_keys.push_back(std::move(l_row));
+        }
+
+        #undef _Nelobin_Column_Entry
+
+        markChanged();
+
+        // Now fill in the values, one column at a time.
+        #define _Nelobin_Column_Values(a_type) \
+            for (U32 r = 0; r < l_rowCount; ++r) \
+            { \
+                a_type l_data {}; \
+                a_buffer.readData<a_type>(l_data); \
+                static_cast<Entry<a_type>&>(*m_keys[l_firstRow + r]->m_entries[c]).set(l_data); \
+            } break;
+
+        for (U32 c = 0; c < l_columnCount; ++c)
+        {
+            if (Private::isIntegerAlias(l_aliases[c]) == true &&
+                l_encodings[c] == Private::G_COLUMN_DELTA)
+            {
+                U32 l_previous = 0;
+                for (U32 r = 0; r < l_rowCount; ++r)
+                {
+                    S32 l_delta = 0;
+                    a_buffer.readData<S32>(l_delta);
+
+                    l_previous += static_cast<U32>(l_delta);
+                    Private::setIntegerBits(*m_keys[l_firstRow + r]->m_entries[c], l_previous);
+                }
+
+                continue;
+            }
+
+            switch (l_aliases[c])
+            {
+            case Datatypes::SignedByte:         _Nelobin_Column_Values(S8)
+            case Datatypes::SignedShort:        _Nelobin_Column_Values(S16)
+            case Datatypes::SignedInteger:      _Nelobin_Column_Values(S32)
+            case Datatypes::UnsignedByte:       _Nelobin_Column_Values(U8)
+            case Datatypes::UnsignedShort:      _Nelobin_Column_Values(U16)
+            case Datatypes::UnsignedInteger:    _Nelobin_Column_Values(U32)
+            case Datatypes::FloatingPoint:      _Nelobin_Column_Values(Float)
+            case Datatypes::StringLiteral:      _Nelobin_Column_Values(String)
+            default:                            break;
+            }
+        }
+
+        #undef _Nelobin_Column_Values
+
+        return true;
+    }
+
     Boolean Key::deserializeNext (Buffer &a_buffer)
     {
         // First, get the binary header.
@@ -165,28 +566,185 @@ namespace Nelobin
         //
         // Are we deserializing an entry or a subkey?
         U32 l_header = 0;
-        a_buffer.readData<U32>(l_header);
+        a_buffer.readHeader(l_header);
+        _Nelobin_Count(RecordsParsed, 1);
 
         // Make sure the header is valid.
         if (l_header == G_ENTRY_HEADER)
             return deserializeEntry(a_buffer);
         else if (l_header == G_KEY_HEADER)
             return deserializeKey(a_buffer);
+        else if (l_header == G_COLUMNS_HEADER)
+            return deserializeColumns(a_buffer);
 
         // If we end up here, then we have an invalid header.
-        _Nelobin_Error("Key::deserializeNext(): In key \"" << m_name << "\":");
+        _Nelobin_Error("Key::deserializeNext(): In key \"" << getName() << "\":");
         _Nelobin_Error("Key::deserializeNext(): Parse error - Invalid header found.");
         return false;
     }
 
+    void Key::collectNames (Buffer &a_buffer) const
+    {
+        for (const auto& l_entry : m_entries)
+            a_buffer.addName(l_entry->getAtom());
+
+        for (const auto& l_key : m_keys)
+        {
+            a_buffer.addName(l_key->m_name);
+            l_key->collectNames(a_buffer);
+        }
+    }
+
     Key::Key (const String &a_name,
               const U32 a_instance,
               Key *ap_parent) :
+        m_name      { Atom::intern(a_name) },
+        m_instance  { a_instance },
+        mp_parent   { ap_parent },
+        m_revision  { 0 },
+        m_serializedSize { 0 },
+        m_imageCached { false }
+    {
+        _Nelobin_Count(KeyAllocations, 1);
+    }
+
+    Key::Key (const Atom &a_name,
+              const U32 a_instance,
+              Key *ap_parent) :
         m_name      { a_name },
         m_instance  { a_instance },
-        mp_parent   { ap_parent }
+        mp_parent   { ap_parent },
+        m_revision  { 0 },
+        m_serializedSize { 0 },
+        m_imageCached { false }
+    {
+        _Nelobin_Count(KeyAllocations, 1);
+    }
+
+    Key::Key (const Key &a_other,
+              Key *ap_parent) :
+        m_name      { a_other.m_name },
+        m_instance  { a_other.m_instance },
+        mp_parent   { ap_parent },
+        m_revision  { 0 },
+        m_serializedSize { 0 },
+        m_imageCached { a_other.m_imageCached }
+    {
+        _Nelobin_Count(KeyAllocations, 1);
+        shareContents(a_other);
+
+        // The copy has the same contents, so it has the same size and image.
+        mp_image = std::atomic_load(&a_other.mp_image);
+        m_serializedSize.store(a_other.m_serializedSize.load(std::memory_order_acquire),
+                               std::memory_order_relaxed);
+    }
+
+    void Key::shareContents (const Key &a_other)
+    {
+        m_entries.clear();
+        m_entries.reserve(a_other.m_entries.size());
+
+        for (const auto& l_entry : a_other.m_entries)
+        {
+            m_entries.push_back(l_entry->clone());
+            m_entries.back()->mp_owner = this;
+        }
+
+        m_keys = a_other.m_keys;
+        markChanged();
+    }
+
+    void Key::takeContents (Key &a_other)
+    {
+        m_entries.swap(a_other.m_entries);
+        m_keys.swap(a_other.m_keys);
+
+        for (auto& l_entry : m_entries)
+            l_entry->mp_owner = this;
+
+        for (auto& l_entry : a_other.m_entries)
+            l_entry->mp_owner = &a_other;
+
+        for (auto& l_key : m_keys)
+            l_key->mp_parent = this;
+
+        // A subkey given back may still be shared with a clone of this key, which
+        // would be left pointing at a parent about to be destroyed.
+        for (auto& l_key : a_other.m_keys)
+        {
+            if (l_key.use_count() == 1)
+                l_key->mp_parent = &a_other;
+        }
+
+        markChanged();
+        a_other.markChanged();
+    }
+
+    void Key::appendContents (Key &a_other)
+    {
+        // Set each entry just as loading it into this key would, so entries of
+        // the same name, and handles to them, are kept.
+        #define _Nelobin_Append_Entry(a_type) \
+            addEntry<a_type>(l_entry->getAtom()).set(static_cast<const Entry<a_type>&>(*l_entry).get()); break;
+
+        for (const auto& l_entry : a_other.m_entries)
+        {
+            switch (l_entry->getAlias())
+            {
+            case Datatypes::SignedByte:         _Nelobin_Append_Entry(S8)
+            case Datatypes::SignedShort:        _Nelobin_Append_Entry(S16)
+            case Datatypes::SignedInteger:      _Nelobin_Append_Entry(S32)
+            case Datatypes::UnsignedByte:       _Nelobin_Append_Entry(U8)
+            case Datatypes::UnsignedShort:      _Nelobin_Append_Entry(U16)
+            case Datatypes::UnsignedInteger:    _Nelobin_Append_Entry(U32)
+            case Datatypes::FloatingPoint:      _Nelobin_Append_Entry(Float)
+            case Datatypes::StringLiteral:      _Nelobin_Append_Entry(String)
+            default:                            break;
+            }
+        }
+
+        #undef _Nelobin_Append_Entry
+
+        // The subkeys are moved over as they are, numbered after this key's own.
+        m_keys.reserve(m_keys.size() + a_other.m_keys.size());
+        for (auto& l_key : a_other.m_keys)
+        {
+            l_key->m_instance = getInstanceCount(l_key->m_name);
+            l_key->mp_parent = this;
+            m_keys.push_back(std::move(l_key));
+        }
+
+        a_other.m_entries.clear();
+        a_other.m_keys.clear();
+
+        markChanged();
+        a_other.markChanged();
+    }
+
+    void Key::markChanged ()
     {
+        Key* lp_root = this;
+        lp_root->m_serializedSize.store(0, std::memory_order_relaxed);
+
+        while (lp_root->mp_parent != nullptr)
+        {
+            lp_root = lp_root->mp_parent;
+            lp_root->m_serializedSize.store(0, std::memory_order_relaxed);
+        }
 
+        lp_root->m_revision++;
+    }
+
+    void Key::markDirty ()
+    {
+        // Walk all the way up. Keys written as columns are never measured on
+        // their own, so a key with nothing cached may still have a parent which
+        // has cached something.
+        for (Key* lp_key = this; lp_key != nullptr; lp_key = lp_key->mp_parent)
+        {
+            if (lp_key->m_serializedSize.load(std::memory_order_relaxed) != 0)
+                lp_key->m_serializedSize.store(0, std::memory_order_relaxed);
+        }
     }
 
     Key::~Key ()
@@ -196,27 +754,77 @@ namespace Nelobin
         m_keys.clear();
     }
 
-    void Key::serialize (Buffer &a_buffer)
+    void Key::serialize (Buffer &a_buffer) const
     {
         // Don't serialize the key if its name is "null".
         // That is a reserved keyword which indicates the "null" key
         // that is returned in case of errors retriving or adding keys.
-        if (m_name == "null")
+        if (m_name.getID() == G_NULL_ATOM)
+            return;
+
+        const U8 l_format = a_buffer.getFormat();
+        if (m_imageCached == false || (l_format & Formats::NameTable) != 0)
+        {
+            serializeContents(a_buffer);
             return;
+        }
+
+        // If the key hasn't changed since its image was cached in this format,
+        // copy the image over as it is.
+        const U64 l_tag = Private::getSizeTag(l_format);
+        if ((m_serializedSize.load(std::memory_order_acquire) & ~Private::G_SIZE_MASK) ==
+            (l_tag | Private::G_SIZE_IMAGED))
+        {
+            auto lp_image = std::atomic_load(&mp_image);
+            if (lp_image != nullptr && lp_image->m_format == l_format)
+            {
+                a_buffer.writeRaw(lp_image->m_bytes.data(), lp_image->m_bytes.size());
+                return;
+            }
+        }
+
+        // Otherwise, encode the key, and keep a copy of what was written.
+        const Size l_start = a_buffer.getSize();
+        serializeContents(a_buffer);
+
+        auto lp_image = std::make_shared<Private::KeyImage>();
+        lp_image->m_format = l_format;
+        lp_image->m_bytes.assign(a_buffer.getData() + l_start, a_buffer.getData() + a_buffer.getSize());
+
+        const U64 l_size = static_cast<U64>(lp_image->m_bytes.size());
+        std::atomic_store(&mp_image, std::shared_ptr<const Private::KeyImage> { std::move(lp_image) });
+        m_serializedSize.store(l_tag | Private::G_SIZE_IMAGED | l_size, std::memory_order_release);
+    }
+
+    void Key::serializeContents (Buffer &a_buffer) const
+    {
+        _Nelobin_TraceKey("serialize-key");
+        _Nelobin_TraceDetail(m_name);
 
         // If the key's name is "root", then that indicates that
         // this is the root key of the Nelobin registry. It is not necessary
         // to record that key's name in the buffer. Do record that name and
         // header if it is not the root.
-        if (m_name != "root")
+        if (m_name.getID() != G_ROOT_ATOM)
         {
-            a_buffer.writeData<U32>(G_KEY_HEADER)
-                    .writeData<String>(m_name);
+            a_buffer.writeHeader(G_KEY_HEADER)
+                    .writeName(m_name);
+        }
+
+        // In the columnar layout, find out which runs of subkeys will be
+        // written as blocks of columns. Each block counts as one entity.
+        const Boolean l_columnar = (a_buffer.getFormat() & Formats::Columnar) != 0;
+        std::vector<Size> l_runs;
+
+        if (l_columnar == true)
+        {
+            for (Size i = 0; i < m_keys.size(); i += l_runs.back())
+                l_runs.push_back(seekColumnRun(i));
         }
 
         // Record the number of entries and subkeys in this key.
         U32 l_entryCount = static_cast<U32>(m_entries.size());
-        U32 l_keyCount   = static_cast<U32>(m_keys.size());
+        U32 l_keyCount   = static_cast<U32>(l_columnar ? l_runs.size() : m_keys.size());
         a_buffer.writeData<U32>(l_entryCount + l_keyCount);
 
         // Record each entry...
@@ -224,11 +832,275 @@ namespace Nelobin
             l_entry->serialize(a_buffer);
 
         // ...and then record each subkey.
-        for (const auto& l_key : m_keys)
-            l_key->serialize(a_buffer);
+        if (l_columnar == false)
+        {
+            for (const auto& l_key : m_keys)
+                l_key->serialize(a_buffer);
+
+            return;
+        }
+
+        Size l_index = 0;
+        for (const Size l_run : l_runs)
+        {
+            if (l_run == 1)
+                m_keys[l_index]->serialize(a_buffer);
+            else
+                serializeColumns(a_buffer, l_index, l_run);
+
+            l_index += l_run;
+        }
+    }
+
+    Boolean Key::hasSameSchema (const Key &a_other) const
+    {
+        if (m_entries.size() != a_other.m_entries.size() ||
+            a_other.m_keys.empty() == false)
+            return false;
+
+        for (Size i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i]->getAtom() != a_other.m_entries[i]->getAtom() ||
+                m_entries[i]->getAlias() != a_other.m_entries[i]->getAlias())
+                return false;
+        }
+
+        return true;
+    }
+
+    Size Key::seekColumnRun (const Size a_from) const
+    {
+        // Only keys holding entries and no subkeys can be written as rows.
+        const Key& l_first = *m_keys[a_from];
+        if (l_first.m_keys.empty() == false || l_first.m_entries.empty() == true)
+            return 1;
+
+        Size l_to = a_from + 1;
+        while (l_to < m_keys.size() &&
+               m_keys[l_to]->m_name == l_first.m_name &&
+               l_first.hasSameSchema(*m_keys[l_to]) == true)
+        {
+            l_to++;
+        }
+
+        return (l_to - a_from >= Private::G_MIN_COLUMN_ROWS) ? l_to - a_from : 1;
+    }
+
+    U8 Key::getColumnEncoding (const Buffer &a_buffer, const Size a_from, const Size a_count,
+                               const Size a_column, Size *ap_size) const
+    {
+        // Integer columns are delta-encoded if that makes them smaller, which it
+        // does for ascending IDs, timestamps and the like. Both sizes are taken
+        // from the buffer, as only a compact buffer writes integers as varints.
+        const U8 l_alias = m_keys[a_from]->m_entries[a_column]->getAlias();
+        if (Private::isIntegerAlias(l_alias) == false)
+            return Private::G_COLUMN_PLAIN;
+
+        Size l_plainSize = 0, l_deltaSize = 0;
+        U32 l_previous = 0;
+
+        for (Size r = a_from; r < a_from + a_count; ++r)
+        {
+            const U32 l_bits = Private::getIntegerBits(*m_keys[r]->m_entries[a_column]);
+            l_plainSize += Private::getPlainSize(a_buffer, l_alias, l_bits);
+            l_deltaSize += a_buffer.getDataSize<S32>(static_cast<S32>(l_bits - l_previous));
+            l_previous = l_bits;
+        }
+
+        if (l_deltaSize < l_plainSize)
+        {
+            if (ap_size != nullptr)
+                *ap_size = l_deltaSize;
+
+            return Private::G_COLUMN_DELTA;
+        }
+
+        if (ap_size != nullptr)
+            *ap_size = l_plainSize;
+
+        return Private::G_COLUMN_PLAIN;
+    }
+
+    void Key::serializeColumns (Buffer &a_buffer, const Size a_from, const Size a_count) const
+    {
+        const Key& l_first = *m_keys[a_from];
+        const Size l_columnCount = l_first.m_entries.size();
+
+        a_buffer.writeHeader(G_COLUMNS_HEADER)
+                .writeName(l_first.m_name)
+                .writeData<U32>(static_cast<U32>(a_count))
+                .writeData<U32>(static_cast<U32>(l_columnCount));
+
+        // Write the schema.
+        std::vector<U8> l_encodings(l_columnCount, Private::G_COLUMN_PLAIN);
+
+        for (Size c = 0; c < l_columnCount; ++c)
+        {
+            l_encodings[c] = getColumnEncoding(a_buffer, a_from, a_count, c, nullptr);
+
+            a_buffer.writeName(l_first.m_entries[c]->getAtom())
+                    .writeData<U8>(l_first.m_entries[c]->getAlias())
+                    .writeData<U8>(l_encodings[c]);
+        }
+
+        // Now write the values, one column at a time.
+        #define _Nelobin_Column_Values(a_type) \
+            for (Size r = a_from; r < a_from + a_count; ++r) \
+                a_buffer.writeData<a_type>(static_cast<const Entry<a_type>&>(*m_keys[r]->m_entries[c]).get()); \
+            break;
+
+        for (Size c = 0; c < l_columnCount; ++c)
+        {
+            if (l_encodings[c] == Private::G_COLUMN_DELTA)
+            {
+                U32 l_previous = 0;
+                for (Size r = a_from; r < a_from + a_count; ++r)
+                {
+                    const U32 l_bits = Private::getIntegerBits(*m_keys[r]->m_entries[c]);
+                    a_buffer.writeData<S32>(static_cast<S32>(l_bits - l_previous));
+                    l_previous = l_bits;
+                }
+
+                continue;
+            }
+
+            switch (l_first.m_entries[c]->getAlias())
+            {
+            case Datatypes::SignedByte:         _Nelobin_Column_Values(S8)
+            case Datatypes::SignedShort:        _Nelobin_Column_Values(S16)
+            case Datatypes::SignedInteger:      _Nelobin_Column_Values(S32)
+            case Datatypes::UnsignedByte:       _Nelobin_Column_Values(U8)
+            case Datatypes::UnsignedShort:      _Nelobin_Column_Values(U16)
+            case Datatypes::UnsignedInteger:    _Nelobin_Column_Values(U32)
+            case Datatypes::FloatingPoint:      _Nelobin_Column_Values(Float)
+            case Datatypes::StringLiteral:      _Nelobin_Column_Values(String)
+            default:                            break;
+            }
+        }
+
+        #undef _Nelobin_Column_Values
+    }
+
+    Size Key::getColumnsSize (const Buffer &a_buffer, const Size a_from, const Size a_count) const
+    {
+        const Key& l_first = *m_keys[a_from];
+        const Size l_columnCount = l_first.m_entries.size();
+
+        Size l_size = a_buffer.getHeaderSize() + a_buffer.getNameSize(l_first.m_name) +
+                      a_buffer.getDataSize<U32>(static_cast<U32>(a_count)) +
+                      a_buffer.getDataSize<U32>(static_cast<U32>(l_columnCount));
+
+        #define _Nelobin_Column_Sizes(a_type) \
+            for (Size r = a_from; r < a_from + a_count; ++r) \
+                l_size += a_buffer.getDataSize<a_type>(static_cast<const Entry<a_type>&>(*m_keys[r]->m_entries[c]).get()); \
+            break;
+
+        for (Size c = 0; c < l_columnCount; ++c)
+        {
+            // The schema...
+            l_size += a_buffer.getNameSize(l_first.m_entries[c]->getAtom()) + sizeof(U8) * 2;
+
+            // ...and the values. Integer columns were sized when their encoding was chosen.
+            Size l_integerSize = 0;
+            getColumnEncoding(a_buffer, a_from, a_count, c, &l_integerSize);
+
+            const U8 l_alias = l_first.m_entries[c]->getAlias();
+            if (Private::isIntegerAlias(l_alias) == true)
+            {
+                l_size += l_integerSize;
+                continue;
+            }
+
+            switch (l_alias)
+            {
+            case Datatypes::SignedByte:         _Nelobin_Column_Sizes(S8)
+            case Datatypes::UnsignedByte:       _Nelobin_Column_Sizes(U8)
+            case Datatypes::FloatingPoint:      _Nelobin_Column_Sizes(Float)
+            case Datatypes::StringLiteral:      _Nelobin_Column_Sizes(String)
+            default:                            break;
+            }
+        }
+
+        #undef _Nelobin_Column_Sizes
+
+        return l_size;
+    }
+
+    Size Key::getSerializedSize (const Buffer &a_buffer) const
+    {
+        // The "null" key is never serialized.
+        if (m_name.getID() == G_NULL_ATOM)
+            return 0;
+
+        // Use the cached size, if it was measured in the same format.
+        const U8 l_format = a_buffer.getFormat();
+        const Boolean l_cacheable = (l_format & Formats::NameTable) == 0;
+        const U64 l_tag = Private::getSizeTag(l_format);
+
+        if (l_cacheable == true)
+        {
+            const U64 l_cached = m_serializedSize.load(std::memory_order_relaxed);
+            if ((l_cached & ~(Private::G_SIZE_MASK | Private::G_SIZE_IMAGED)) == l_tag)
+                return static_cast<Size>(l_cached & Private::G_SIZE_MASK);
+        }
+
+        // Measure the key as 'serialize' would write it.
+        Size l_size = 0;
+        if (m_name.getID() != G_ROOT_ATOM)
+            l_size += a_buffer.getHeaderSize() + a_buffer.getNameSize(m_name);
+
+        const Boolean l_columnar = (l_format & Formats::Columnar) != 0;
+        std::vector<Size> l_runs;
+
+        if (l_columnar == true)
+        {
+            for (Size i = 0; i < m_keys.size(); i += l_runs.back())
+                l_runs.push_back(seekColumnRun(i));
+        }
+
+        U32 l_entryCount = static_cast<U32>(m_entries.size());
+        U32 l_keyCount   = static_cast<U32>(l_columnar ? l_runs.size() : m_keys.size());
+        l_size += a_buffer.getDataSize<U32>(l_entryCount + l_keyCount);
+
+        for (const auto& l_entry : m_entries)
+            l_size += l_entry->getSerializedSize(a_buffer);
+
+        if (l_columnar == false)
+        {
+            for (const auto& l_key : m_keys)
+                l_size += l_key->getSerializedSize(a_buffer);
+        }
+        else
+        {
+            Size l_index = 0;
+            for (const Size l_run : l_runs)
+            {
+                if (l_run == 1)
+                    l_size += m_keys[l_index]->getSerializedSize(a_buffer);
+                else
+                    l_size += getColumnsSize(a_buffer, l_index, l_run);
+
+                l_index += l_run;
+            }
+        }
+
+        if (l_cacheable == true)
+            m_serializedSize.store(l_tag | static_cast<U64>(l_size), std::memory_order_relaxed);
+
+        return l_size;
     }
 
     U32 Key::getInstanceCount (const String &a_name)
+    {
+        // A name which was never interned can't belong to any subkey.
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return 0;
+
+        return getInstanceCount(l_atom);
+    }
+
+    U32 Key::getInstanceCount (const Atom &a_name)
     {
         U32 l_return = 0;
         auto l_iter = m_keys.begin();
@@ -243,7 +1115,10 @@ namespace Nelobin
                 break;
             else
             {
-                (*l_iter)->m_instance = l_return;
+                // Don't copy a shared subkey unless its ID actually changes.
+                if ((*l_iter)->m_instance != l_return)
+                    detach(*l_iter).m_instance = l_return;
+
                 l_return++;
                 l_iter += 1;
             }
@@ -255,7 +1130,7 @@ namespace Nelobin
     void Key::rename (const String &a_name)
     {
         // Store the key's old name.
-        String l_oldName = m_name;
+        Atom l_oldName = m_name;
 
         // Check to see if this is the root key. The root key cannot
         // be renamed.
@@ -268,95 +1143,130 @@ namespace Nelobin
         // Don't rename if the new name is empty or reserved.
         if (a_name.empty() == true)
         {
-            _Nelobin_Error("Key::rename(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::rename(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::rename(): No name specified for subkey.");
             return;
         }
         else if (a_name == "root" || a_name == "null")
         {
-            _Nelobin_Error("Key::rename(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::rename(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::rename(): \"" << a_name << "\" is reserved.");
             return;
         }
 
         // Change the name of the key.
-        m_name = a_name;
+        m_name = Atom::intern(a_name);
+        markChanged();
 
         // Now refresh the instance ID of keys with this new name and
         // keys with the old name.
         mp_parent->getInstanceCount(l_oldName);
-        mp_parent->getInstanceCount(a_name);
+        mp_parent->getInstanceCount(m_name);
     }
 
     Key& Key::getKey (const String &a_name, const U32 a_instance)
     {
+        _Nelobin_Count(KeyLookups, 1);
+
         // Don't try to find a key with no name, or an invalid name.
         if (a_name.empty() == true)
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): No name specified for subkey.");
-            return Key::s_null;
+            return Key::getNull();
         }
         else if (a_name == "root" || a_name == "null")
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): \"" << a_name << "\" is reserved.");
-            return Key::s_null;
+            return Key::getNull();
         }
 
         // Now check to see if the key exists.
         auto l_find = seekKey(a_name, a_instance);
         if (l_find == m_keys.end())
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): Key \"" << a_name << "\" (" << a_instance << ") not found.");
-            return Key::s_null;
+            _Nelobin_Count(KeyMisses, 1);
+            return Key::getNull();
         }
 
         // Return what we found.
-        return *(*l_find);
+        return detach(*l_find);
     }
 
     const Key& Key::getKey (const String &a_name, const U32 a_instance) const
     {
+        _Nelobin_Count(KeyLookups, 1);
+
         // Don't try to find a key with no name, or an invalid name.
         if (a_name.empty() == true)
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): No name specified for subkey.");
-            return Key::s_null;
+            return Key::getNull();
         }
         else if (a_name == "root" || a_name == "null")
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): \"" << a_name << "\" is reserved.");
-            return Key::s_null;
+            return Key::getNull();
         }
 
         // Now check to see if the key exists.
         auto l_find = cseekKey(a_name, a_instance);
         if (l_find == m_keys.cend())
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): Key \"" << a_name << "\" (" << a_instance << ") not found.");
-            return Key::s_null;
+            _Nelobin_Count(KeyMisses, 1);
+            return Key::getNull();
         }
 
         // Return what we found.
         return *(*l_find);
     }
 
+    Key* Key::tryGetKey (const String &a_name, const U32 a_instance)
+    {
+        _Nelobin_Count(KeyLookups, 1);
+
+        auto l_find = seekKey(a_name, a_instance);
+        if (l_find == m_keys.end())
+        {
+            _Nelobin_Count(KeyMisses, 1);
+            return nullptr;
+        }
+
+        return &detach(*l_find);
+    }
+
+    const Key* Key::tryGetKey (const String &a_name, const U32 a_instance) const
+    {
+        _Nelobin_Count(KeyLookups, 1);
+
+        auto l_find = cseekKey(a_name, a_instance);
+        if (l_find == m_keys.cend())
+        {
+            _Nelobin_Count(KeyMisses, 1);
+            return nullptr;
+        }
+
+        return l_find->get();
+    }
+
     Key& Key::getKey (const Size a_index)
     {
         // Check to see if we are in bounds.
         if (a_index >= m_keys.size())
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): Index " << a_index << " is out of range.");
-            return Key::s_null;
+            return Key::getNull();
         }
 
-        return *m_keys[a_index];
+        return detach(m_keys[a_index]);
     }
 
     const Key& Key::getKey (const Size a_index) const
@@ -364,9 +1274,9 @@ namespace Nelobin
         // Check to see if we are in bounds.
         if (a_index >= m_keys.size())
         {
-            _Nelobin_Error("Key::getKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::getKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::getKey(): Index " << a_index << " is out of range.");
-            return Key::s_null;
+            return Key::getNull();
         }
 
         return *m_keys[a_index];
@@ -377,15 +1287,34 @@ namespace Nelobin
         // Don't try to add a key with no name, or an invalid name.
         if (a_name.empty() == true)
         {
-            _Nelobin_Error("Key::addKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::addKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::addKey(): No name specified for subkey.");
-            return Key::s_null;
+            return Key::getNull();
         }
         else if (a_name == "root" || a_name == "null")
         {
-            _Nelobin_Error("Key::addKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::addKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::addKey(): \"" << a_name << "\" is reserved.");
-            return Key::s_null;
+            return Key::getNull();
+        }
+
+        return addKey(Atom::intern(a_name));
+    }
+
+    Key& Key::addKey (const Atom &a_name)
+    {
+        // Don't try to add a key with no name, or an invalid name.
+        if (a_name.isEmpty() == true)
+        {
+            _Nelobin_Error("Key::addKey(): In key \"" << getName() << "\":");
+            _Nelobin_Error("Key::addKey(): No name specified for subkey.");
+            return Key::getNull();
+        }
+        else if (a_name.isReserved() == true)
+        {
+            _Nelobin_Error("Key::addKey(): In key \"" << getName() << "\":");
+            _Nelobin_Error("Key::addKey(): \"" << a_name.getString() << "\" is reserved.");
+            return Key::getNull();
         }
 
         // Generate the new key's instance ID, and update those of other
@@ -396,16 +1325,36 @@ namespace Nelobin
         Key* lp_new = new Key(a_name, l_instance, this);
         Key::Ptr l_wrap { lp_new };
         m_keys.push_back(std::move(l_wrap));
+        markChanged();
         return *lp_new;
     }
 
+    Key& Key::addCopy (const Key &a_key)
+    {
+        // Make sure a real key was given.
+        if (a_key.isNull() == true || a_key.m_name.getID() == G_ROOT_ATOM)
+        {
+            _Nelobin_Error("Key::addCopy(): In key \"" << getName() << "\":");
+            _Nelobin_Error("Key::addCopy(): The \"null\" and \"root\" keys cannot be copied.");
+            return Key::getNull();
+        }
+
+        // Copy the key before adding it, in case the key is this one, or one of
+        // its ancestors, which would otherwise end up holding itself.
+        Key::Ptr l_copy { new Key(a_key, this) };
+        l_copy->m_instance = getInstanceCount(a_key.m_name);
+        m_keys.push_back(l_copy);
+        markChanged();
+        return *l_copy;
+    }
+
     void Key::removeKey (const String &a_name, const U32 a_instance)
     {
         // Check to see if the key could be found.
         auto l_find = seekKey(a_name, a_instance);
         if (l_find == m_keys.end())
         {
-            _Nelobin_Error("Key::removeKey(): In key \"" << m_name << "\":");
+            _Nelobin_Error("Key::removeKey(): In key \"" << getName() << "\":");
             _Nelobin_Error("Key::removeKey(): Key \"" << a_name << "\" (" << a_instance << ") not found.");
             return;
         }
@@ -414,15 +1363,164 @@ namespace Nelobin
         // name.
         l_find = m_keys.erase(l_find);
         getInstanceCount(a_name);
+        markChanged();
+    }
+
+    void Key::setImageCached (const Boolean a_cached)
+    {
+        m_imageCached = a_cached;
+
+        if (a_cached == false)
+        {
+            m_serializedSize.fetch_and(~Private::G_SIZE_IMAGED, std::memory_order_relaxed);
+            std::atomic_store(&mp_image, std::shared_ptr<const Private::KeyImage> {});
+        }
+    }
+
+    Boolean Key::isImageCached () const
+    {
+        return m_imageCached;
     }
 
     void Key::clear ()
     {
         m_keys.clear();
         m_entries.clear();
+        markChanged();
+    }
+
+    void Key::measure (MemoryUsage &a_usage, std::unordered_map<U32, Size> &a_names, String &a_path,
+                       std::vector<PathUsage> *ap_paths, const Size a_count) const
+    {
+        a_usage = MemoryUsage {};
+        a_usage.m_keys = 1;
+        a_usage.m_entries = m_entries.size();
+        a_usage.m_nodes = sizeof(Key) + m_entries.size() * sizeof(EntryBase::Ptr) +
+                          m_keys.size() * sizeof(Key::Ptr);
+        a_usage.m_slack = (m_entries.capacity() - m_entries.size()) * sizeof(EntryBase::Ptr) +
+                          (m_keys.capacity() - m_keys.size()) * sizeof(Key::Ptr);
+
+        const Buffer l_standard;
+        a_usage.m_serialized = getSerializedSize(l_standard);
+
+        auto lp_image = std::atomic_load(&mp_image);
+        if (lp_image != nullptr)
+            a_usage.m_images = sizeof(Private::KeyImage) + lp_image->m_bytes.capacity();
+
+        a_usage.m_names = Private::getNameSize(m_name);
+        a_names.emplace(m_name.getID(), a_usage.m_names);
+
+        for (const auto& l_entry : m_entries)
+        {
+            a_usage.m_nodes += Private::getEntryObjectSize(l_entry->getAlias());
+
+            if (l_entry->getAlias() == Datatypes::StringLiteral)
+            {
+                const String& l_value = static_cast<const Entry<String>&>(*l_entry).get();
+                if (Private::getStringHeapSize(l_value) != 0)
+                {
+                    a_usage.m_strings += l_value.size() + 1;
+                    a_usage.m_slack += l_value.capacity() - l_value.size();
+                }
+            }
+
+            auto l_insert = a_names.emplace(l_entry->getAtom().getID(), 0);
+            if (l_insert.second == true)
+            {
+                l_insert.first->second = Private::getNameSize(l_entry->getAtom());
+                a_usage.m_names += l_insert.first->second;
+            }
+        }
+
+        for (const auto& l_key : m_keys)
+        {
+            const Size l_length = a_path.size();
+            if (a_path.empty() == false)
+                a_path += '/';
+
+            a_path += l_key->getName();
+            if (l_key->m_instance != 0)
+                a_path += ':' + std::to_string(l_key->m_instance);
+
+            MemoryUsage l_usage;
+            std::unordered_map<U32, Size> l_names;
+            l_key->measure(l_usage, l_names, a_path, ap_paths, a_count);
+            l_usage.m_nodes += Private::G_SHARED_BLOCK_SIZE;
+
+            // Keep the heaviest subkeys in a min-heap, so the lightest is the one replaced.
+            if (ap_paths != nullptr)
+            {
+                if (ap_paths->size() < a_count)
+                {
+                    ap_paths->push_back({ a_path, l_usage });
+                    std::push_heap(ap_paths->begin(), ap_paths->end(), Private::isHeavierPath);
+                }
+                else if (l_usage.getTotal() > ap_paths->front().m_usage.getTotal())
+                {
+                    std::pop_heap(ap_paths->begin(), ap_paths->end(), Private::isHeavierPath);
+                    ap_paths->back() = { a_path, l_usage };
+                    std::push_heap(ap_paths->begin(), ap_paths->end(), Private::isHeavierPath);
+                }
+            }
+
+            a_path.resize(l_length);
+
+            // Merge the smaller set of names into the larger, so that each name is
+            // moved no more than a logarithmic number of times.
+            if (l_names.size() > a_names.size())
+            {
+                a_names.swap(l_names);
+                std::swap(a_usage.m_names, l_usage.m_names);
+            }
+
+            for (const auto& l_name : l_names)
+            {
+                if (a_names.insert(l_name).second == true)
+                    a_usage.m_names += l_name.second;
+            }
+
+            a_usage.m_keys += l_usage.m_keys;
+            a_usage.m_entries += l_usage.m_entries;
+            a_usage.m_nodes += l_usage.m_nodes;
+            a_usage.m_strings += l_usage.m_strings;
+            a_usage.m_slack += l_usage.m_slack;
+            a_usage.m_images += l_usage.m_images;
+        }
+    }
+
+    MemoryUsage Key::getMemoryUsage () const
+    {
+        MemoryUsage l_usage;
+        std::unordered_map<U32, Size> l_names;
+        String l_path = "";
+
+        measure(l_usage, l_names, l_path, nullptr, 0);
+        return l_usage;
+    }
+
+    std::vector<PathUsage> Key::getHeaviestPaths (const Size a_count) const
+    {
+        std::vector<PathUsage> l_paths;
+        if (a_count == 0)
+            return l_paths;
+
+        MemoryUsage l_usage;
+        std::unordered_map<U32, Size> l_names;
+        String l_path = "";
+
+        measure(l_usage, l_names, l_path, &l_paths, a_count);
+
+        // Sorting the heap with its own ordering puts the heaviest paths first.
+        std::sort_heap(l_paths.begin(), l_paths.end(), Private::isHeavierPath);
+        return l_paths;
     }
 
     const String& Key::getName () const
+    {
+        return m_name.getString();
+    }
+
+    const Atom& Key::getAtom () const
     {
         return m_name;
     }
@@ -444,7 +1542,7 @@ namespace Nelobin
 
     Boolean Key::isNull () const
     {
-        return m_name == "null";
+        return m_name.getID() == G_NULL_ATOM;
     }
 
     Boolean Key::isParent () const
@@ -452,6 +1550,11 @@ namespace Nelobin
         return isNull() == false && mp_parent == nullptr;
     }
 
+    Size Key::getRevision () const
+    {
+        return m_revision;
+    }
+
     Key& Key::getParent ()
     {
         if (mp_parent == nullptr)
@@ -0,0 +1,181 @@
+///
+/// \file   MappedFile.cpp
+///
+
+#include <Nelobin/MappedFile.hpp>
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace Nelobin
+{
+
+    MappedFile::MappedFile () :
+        mp_data     { nullptr },
+        m_size      { 0 },
+        m_writable  { false }
+    {
+
+    }
+
+    MappedFile::~MappedFile ()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile (MappedFile &&a_other) :
+        MappedFile {}
+    {
+        *this = std::move(a_other);
+    }
+
+    MappedFile& MappedFile::operator= (MappedFile &&a_other)
+    {
+        if (this == &a_other)
+            return *this;
+
+        close();
+
+        mp_data = a_other.mp_data;
+        m_size = a_other.m_size;
+        m_writable = a_other.m_writable;
+
+        a_other.mp_data = nullptr;
+        a_other.m_size = 0;
+        a_other.m_writable = false;
+
+        return *this;
+    }
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+
+    Status MappedFile::map (const int a_descriptor, const Boolean a_writable)
+    {
+        struct stat l_stat;
+        if (fstat(a_descriptor, &l_stat) != 0 || l_stat.st_size <= 0)
+        {
+            ::close(a_descriptor);
+            return Status::FileLoadError;
+        }
+
+        void* lp_data = mmap(nullptr, static_cast<Size>(l_stat.st_size),
+                             (a_writable == true) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                             MAP_SHARED, a_descriptor, 0);
+
+        // The mapping holds its own reference to the file.
+        ::close(a_descriptor);
+
+        if (lp_data == MAP_FAILED)
+            return Status::FileLoadError;
+
+        mp_data = static_cast<char*>(lp_data);
+        m_size = static_cast<Size>(l_stat.st_size);
+        m_writable = a_writable;
+        return Status::OK;
+    }
+
+    Status MappedFile::open (const String &a_filename, const Boolean a_writable)
+    {
+        close();
+
+        if (a_filename.empty() == true)
+            return Status::NoName;
+
+        int l_descriptor = ::open(a_filename.c_str(), (a_writable == true) ? O_RDWR : O_RDONLY);
+        if (l_descriptor < 0)
+        {
+            _Nelobin_Error("MappedFile::open(): Could not open \"" << a_filename << "\".");
+            return Status::FileLoadError;
+        }
+
+        Status l_status = map(l_descriptor, a_writable);
+        if (l_status != Status::OK)
+            _Nelobin_Error("MappedFile::open(): Could not map \"" << a_filename << "\".");
+
+        return l_status;
+    }
+
+    Status MappedFile::openSharedMemory (const String &a_name)
+    {
+        close();
+
+        if (a_name.empty() == true)
+            return Status::NoName;
+
+        int l_descriptor = shm_open(a_name.c_str(), O_RDONLY, 0);
+        if (l_descriptor < 0)
+        {
+            _Nelobin_Error("MappedFile::openSharedMemory(): Could not open shared memory segment \"" << a_name << "\".");
+            return Status::FileLoadError;
+        }
+
+        Status l_status = map(l_descriptor, false);
+        if (l_status != Status::OK)
+            _Nelobin_Error("MappedFile::openSharedMemory(): Could not map shared memory segment \"" << a_name << "\".");
+
+        return l_status;
+    }
+
+    Status MappedFile::sync (const Size a_offset, const Size a_length)
+    {
+        if (m_writable == false || a_offset > m_size || a_length > m_size - a_offset)
+            return Status::FileSaveError;
+
+        // 'msync' wants an address aligned to a page.
+        const Size l_page = static_cast<Size>(sysconf(_SC_PAGESIZE));
+        const Size l_begin = a_offset - (a_offset % l_page);
+
+        if (msync(mp_data + l_begin, a_offset + a_length - l_begin, MS_SYNC) != 0)
+            return Status::FileSaveError;
+
+        return Status::OK;
+    }
+
+    void MappedFile::close ()
+    {
+        if (mp_data != nullptr)
+            munmap(mp_data, m_size);
+
+        mp_data = nullptr;
+        m_size = 0;
+        m_writable = false;
+    }
+
+#else
+
+    Status MappedFile::map (const int, const Boolean)
+    {
+        return Status::FileLoadError;
+    }
+
+    Status MappedFile::open (const String &a_filename, const Boolean)
+    {
+        _Nelobin_Error("MappedFile::open(): Memory mapping is not supported on this platform. Could not map \"" << a_filename << "\".");
+        return Status::FileLoadError;
+    }
+
+    Status MappedFile::openSharedMemory (const String &a_name)
+    {
+        _Nelobin_Error("MappedFile::openSharedMemory(): Shared memory is not supported on this platform. Could not map \"" << a_name << "\".");
+        return Status::FileLoadError;
+    }
+
+    Status MappedFile::sync (const Size, const Size)
+    {
+        return Status::FileSaveError;
+    }
+
+    void MappedFile::close ()
+    {
+        mp_data = nullptr;
+        m_size = 0;
+        m_writable = false;
+    }
+
+#endif
+
+}
@@ -0,0 +1,208 @@
+///
+/// \file   MappedRegistry.cpp
+///
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <Nelobin/MappedRegistry.hpp>
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+namespace Nelobin
+{
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+
+    Status MappedRegistry::writeFile (const String &a_filename, const FrozenRegistry &a_registry)
+    {
+        if (a_filename.empty() == true)
+        {
+            _Nelobin_Error("MappedRegistry::writeFile(): No filename specified.");
+            return Status::NoName;
+        }
+
+        if (a_registry.isEmpty() == true)
+        {
+            _Nelobin_Error("MappedRegistry::writeFile(): The registry given is empty.");
+            return Status::FileSaveError;
+        }
+
+        // Write the image beside the file, then move it into place, so that
+        // nobody maps a half-written image. The temporary file's name is made
+        // unique, so that two processes writing the same file at once never
+        // write into each other's.
+        String l_temporary = a_filename + ".XXXXXX";
+
+        int l_descriptor = mkstemp(&l_temporary[0]);
+        if (l_descriptor < 0)
+        {
+            _Nelobin_Error("MappedRegistry::writeFile(): Could not create a temporary file beside \"" << a_filename << "\".");
+            return Status::FileSaveError;
+        }
+
+        // 'mkstemp' makes the file readable by its owner alone.
+        Boolean l_ok = (fchmod(l_descriptor, 0644) == 0);
+
+        const char* lp_image = static_cast<const char*>(a_registry.getImage());
+        const Size l_size = a_registry.getImageSize();
+        Size l_written = 0;
+
+        while (l_ok == true && l_written < l_size)
+        {
+            ssize_t l_result = ::write(l_descriptor, lp_image + l_written, l_size - l_written);
+            if (l_result < 0 && errno == EINTR)
+                continue;
+            else if (l_result <= 0)
+                l_ok = false;
+            else
+                l_written += static_cast<Size>(l_result);
+        }
+
+        if (::close(l_descriptor) != 0)
+            l_ok = false;
+
+        if (l_ok == false || std::rename(l_temporary.c_str(), a_filename.c_str()) != 0)
+        {
+            _Nelobin_Error("MappedRegistry::writeFile(): Could not write \"" << a_filename << "\".");
+            std::remove(l_temporary.c_str());
+            return Status::FileSaveError;
+        }
+
+        return Status::OK;
+    }
+
+    Status MappedRegistry::writeSharedMemory (const String &a_name, const FrozenRegistry &a_registry)
+    {
+        if (a_name.empty() == true)
+        {
+            _Nelobin_Error("MappedRegistry::writeSharedMemory(): No segment name specified.");
+            return Status::NoName;
+        }
+
+        if (a_registry.isEmpty() == true)
+        {
+            _Nelobin_Error("MappedRegistry::writeSharedMemory(): The registry given is empty.");
+            return Status::FileSaveError;
+        }
+
+        // Unlink the old segment, rather than writing over it, so that processes
+        // which have mapped it keep an intact image.
+        shm_unlink(a_name.c_str());
+
+        int l_descriptor = shm_open(a_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (l_descriptor < 0)
+        {
+            _Nelobin_Error("MappedRegistry::writeSharedMemory(): Could not create shared memory segment \"" << a_name << "\".");
+            return Status::FileSaveError;
+        }
+
+        const Size l_size = a_registry.getImageSize();
+        void* lp_data = MAP_FAILED;
+
+        if (ftruncate(l_descriptor, static_cast<off_t>(l_size)) == 0)
+            lp_data = mmap(nullptr, l_size, PROT_READ | PROT_WRITE, MAP_SHARED, l_descriptor, 0);
+
+        ::close(l_descriptor);
+
+        if (lp_data == MAP_FAILED)
+        {
+            _Nelobin_Error("MappedRegistry::writeSharedMemory(): Could not map shared memory segment \"" << a_name << "\".");
+            shm_unlink(a_name.c_str());
+            return Status::FileSaveError;
+        }
+
+        // A process may open the segment as soon as it is created. Copy the image
+        // in with its leading magic number cleared, and set that last, so that a
+        // half-written image is never taken for a valid one.
+        const char* lp_image = static_cast<const char*>(a_registry.getImage());
+        char* lp_segment = static_cast<char*>(lp_data);
+
+        std::memcpy(lp_segment + sizeof(U32), lp_image + sizeof(U32), l_size - sizeof(U32));
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(lp_segment, lp_image, sizeof(U32));
+
+        munmap(lp_data, l_size);
+        return Status::OK;
+    }
+
+    void MappedRegistry::removeSharedMemory (const String &a_name)
+    {
+        shm_unlink(a_name.c_str());
+    }
+
+#else
+
+    Status MappedRegistry::writeFile (const String &a_filename, const FrozenRegistry &)
+    {
+        _Nelobin_Error("MappedRegistry::writeFile(): Memory mapping is not supported on this platform. Could not write \"" << a_filename << "\".");
+        return Status::FileSaveError;
+    }
+
+    Status MappedRegistry::writeSharedMemory (const String &a_name, const FrozenRegistry &)
+    {
+        _Nelobin_Error("MappedRegistry::writeSharedMemory(): Shared memory is not supported on this platform. Could not write \"" << a_name << "\".");
+        return Status::FileSaveError;
+    }
+
+    void MappedRegistry::removeSharedMemory (const String &)
+    {
+
+    }
+
+#endif
+
+    MappedRegistry::MappedRegistry ()
+    {
+
+    }
+
+    Status MappedRegistry::openFile (const String &a_filename)
+    {
+        close();
+
+        Status l_status = m_file.open(a_filename);
+        if (l_status != Status::OK)
+            return l_status;
+
+        l_status = m_registry.attach(m_file.getData(), m_file.getSize());
+        if (l_status != Status::OK)
+        {
+            _Nelobin_Error("MappedRegistry::openFile(): \"" << a_filename << "\" does not hold a registry image.");
+            m_file.close();
+        }
+
+        return l_status;
+    }
+
+    Status MappedRegistry::openSharedMemory (const String &a_name)
+    {
+        close();
+
+        Status l_status = m_file.openSharedMemory(a_name);
+        if (l_status != Status::OK)
+            return l_status;
+
+        l_status = m_registry.attach(m_file.getData(), m_file.getSize());
+        if (l_status != Status::OK)
+        {
+            _Nelobin_Error("MappedRegistry::openSharedMemory(): \"" << a_name << "\" does not hold a registry image.");
+            m_file.close();
+        }
+
+        return l_status;
+    }
+
+    void MappedRegistry::close ()
+    {
+        m_registry = FrozenRegistry {};
+        m_file.close();
+    }
+
+}
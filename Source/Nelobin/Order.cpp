@@ -13,28 +13,36 @@ namespace Nelobin
         const U8 G_LITTLE_ENDIAN  = 0x01;
         const U8 G_BIG_ENDIAN     = 0x02;
 
+        ///
+        /// \fn     detectEndian
+        /// \brief  Determines the endianness of the running machine.
+        ///
+        static U8 detectEndian ()
+        {
+            // Get the four bytes from a 32-bit integer.
+            U32 l_int = 1;
+            U8* lp_bytes = reinterpret_cast<U8*>(&l_int);
+
+            // Check to see where the most significant byte is in order
+            // to determine endianness.
+            if (lp_bytes[0] == 0x00)
+                return G_BIG_ENDIAN;
+            else if (lp_bytes[0] == 0x01)
+                return G_LITTLE_ENDIAN;
+
+            return G_UNKNOWN_ENDIAN;
+        }
+
         ///
         /// \fn     checkEndian
-        /// \brief  Determines and returns the endianness of the running machine.
+        /// \brief  Returns the endianness of the running machine.
+        ///
+        /// The endianness is detected once, on first use. The initialization of
+        /// a local static is thread-safe, so this may be called from any thread.
         ///
         static U8 checkEndian ()
         {
-            static U8 s_endian = G_UNKNOWN_ENDIAN;
-
-            if (s_endian == G_UNKNOWN_ENDIAN)
-            {
-                // Get the four bytes from a 32-bit integer.
-                U32 l_int = 1;
-                U8* lp_bytes = reinterpret_cast<U8*>(&l_int);
-
-                // Check to see where the most significant byte is in order
-                // to determine endianness.
-                if (lp_bytes[0] == 0x00)
-                    s_endian = G_BIG_ENDIAN;
-                else if (lp_bytes[0] == 0x01)
-                    s_endian = G_LITTLE_ENDIAN;
-            }
-
+            static const U8 s_endian = detectEndian();
             return s_endian;
         }
 
@@ -2,7 +2,9 @@
 /// \file   Registry.cpp
 ///
 
+#include <Nelobin/Executor.hpp>
 #include <Nelobin/Registry.hpp>
+#include <Nelobin/Tracing.hpp>
 
 namespace Nelobin
 {
@@ -21,13 +23,19 @@ namespace Nelobin
 
     Status Registry::loadFromBuffer (Buffer &a_buffer, const Boolean a_append)
     {
+        _Nelobin_Count(Loads, 1);
+        _Nelobin_Count(BytesParsed, a_buffer.getRemaining());
+        _Nelobin_Time(LoadNanoseconds);
+        _Nelobin_Trace("parse");
+
         // If the user does not want to append this registry, then
         // clear all other entries in here.
         if (a_append == false)
-        {
-            m_entries.clear();
-            m_keys.clear();
-        }
+            clear();
+
+        // If the registry was saved with a name table, it comes first.
+        if (a_buffer.hasNameTable() == true)
+            a_buffer.readNameTable();
 
         // Get the number of entities expected.
         U32 l_entityCount = 0;
@@ -45,6 +53,8 @@ namespace Nelobin
 
     Status Registry::loadFromFile (const String &a_filename, const Boolean a_append)
     {
+        _Nelobin_Trace("load");
+
         // Don't do anything if there is no filename specified.
         if (a_filename.empty() == true)
         {
@@ -60,43 +70,87 @@ namespace Nelobin
             return Status::FileLoadError;
         }
 
-        // Check the start of the file for a valid file header.
-        U32 l_fileHeader = 0;
-        U16 l_fileVersion = 0;
-
-        l_buffer.readData<U32>(l_fileHeader)
-                .readData<U16>(l_fileVersion);
-
-        // Check to see if the header and version found are valid.
-        if (l_fileHeader != G_REGISTRY_HEADER)
-        {
-            _Nelobin_Error("Registry::loadFromFile(): Error loading \"" << a_filename << "\" - Invalid file header.");
-            return Status::FileParseError;
-        }
-        else if (l_fileVersion != G_VERSION)
+        // Now load our keys and entries from the file's contents.
+        if (loadFromFileBuffer(l_buffer, a_append) != Status::OK)
         {
-            _Nelobin_Error("Registry::loadFromFile(): Error loading \"" << a_filename << "\" - Version mismatch.");
+            _Nelobin_Error("Registry::loadFromFile(): Error parsing registry file \"" << a_filename << "\".");
             return Status::FileParseError;
         }
 
-        // Now load our keys and entries from the buffer.
-        if (loadFromBuffer(l_buffer, a_append) != Status::OK)
+        return Status::OK;
+    }
+
+    Status Registry::loadFromFileBuffer (Buffer &a_buffer, const Boolean a_append)
+    {
+        // Check the start of the file for a valid file header.
         {
-            _Nelobin_Error("Registry::loadFromFile(): Error parsing registry file \"" << a_filename << "\".");
-            return Status::FileParseError;
+            _Nelobin_Trace("check-header");
+
+            U32 l_fileHeader = 0;
+            U16 l_fileVersion = 0;
+
+            a_buffer.readData<U32>(l_fileHeader)
+                    .readData<U16>(l_fileVersion);
+
+            // Check to see if the header and version found are valid.
+            if (l_fileHeader != G_REGISTRY_HEADER)
+            {
+                _Nelobin_Error("Registry::loadFromFileBuffer(): Invalid file header.");
+                return Status::FileParseError;
+            }
+            else if (l_fileVersion == G_VERSION_COMPACT)
+            {
+                // Compact files store their format flags just after the version.
+                U8 l_format = 0;
+                a_buffer.readData<U8>(l_format);
+
+                const U8 l_known = Formats::Compact | Formats::NameTable | Formats::Columnar;
+                if ((l_format & Formats::Compact) == 0 || (l_format & ~l_known) != 0)
+                {
+                    _Nelobin_Error("Registry::loadFromFileBuffer(): Unsupported format flags.");
+                    return Status::FileParseError;
+                }
+
+                a_buffer.setFormat(l_format);
+            }
+            else if (l_fileVersion != G_VERSION)
+            {
+                _Nelobin_Error("Registry::loadFromFileBuffer(): Version mismatch.");
+                return Status::FileParseError;
+            }
         }
 
-        return Status::OK;
+        return loadFromBuffer(a_buffer, a_append);
     }
 
-    Status Registry::saveToBuffer (Buffer &a_buffer)
+    Status Registry::saveToBuffer (Buffer &a_buffer) const
     {
+        _Nelobin_Count(Saves, 1);
+        _Nelobin_Time(SaveNanoseconds);
+        _Nelobin_Trace("serialize");
+
+        // If a name table is used, gather every name in the registry and write
+        // the table before any of the records that refer to it.
+        if (a_buffer.hasNameTable() == true)
+        {
+            collectNames(a_buffer);
+            a_buffer.writeNameTable();
+        }
+
+        // Measure the registry first, so that the buffer grows just once. Sizes
+        // measured against a name table can't be cached, and measuring them
+        // afresh costs more than growing the buffer as it's written.
+        if (a_buffer.hasNameTable() == false)
+            a_buffer.reserve(a_buffer.getSize() + getSerializedSize(a_buffer));
+
         serialize(a_buffer);
         return Status::OK;
     }
 
-    Status Registry::saveToFile (const String &a_filename)
+    Status Registry::saveToFile (const String &a_filename, const U8 a_format) const
     {
+        _Nelobin_Trace("save");
+
         // Don't do anything if there is no filename specified.
         if (a_filename.empty() == true)
         {
@@ -104,10 +158,24 @@ namespace Nelobin
             return Status::NoName;
         }
 
-        // Create the buffer and write the file header.
+        // Create the buffer and write the file header. The header is always
+        // written in the standard format, so that the version can be read
+        // back before the file's format is known.
         Buffer l_buffer;
-        l_buffer.writeData<U32>(G_REGISTRY_HEADER)
-                .writeData<U16>(G_VERSION);
+        l_buffer.writeData<U32>(G_REGISTRY_HEADER);
+
+        if (a_format == Formats::Standard)
+        {
+            l_buffer.writeData<U16>(G_VERSION);
+        }
+        else
+        {
+            // Every other format builds on the compact encoding.
+            const U8 l_format = a_format | Formats::Compact;
+            l_buffer.writeData<U16>(G_VERSION_COMPACT)
+                    .writeData<U8>(l_format);
+            l_buffer.setFormat(l_format);
+        }
 
         // Now serialize the contents of our registry.
         if (saveToBuffer(l_buffer) != Status::OK)
@@ -126,4 +194,60 @@ namespace Nelobin
         return Status::OK;
     }
 
+    std::future<Status> Registry::loadFromFileAsync (const String &a_filename, const Boolean a_append)
+    {
+        return Executor::getDefault().submit([this, a_filename, a_append] ()
+        {
+            // The file is parsed into a registry of its own, which shares nothing
+            // with this one.
+            std::unique_ptr<Registry> l_loaded { new Registry() };
+
+            Status l_status = l_loaded->loadFromFile(a_filename);
+            if (l_status != Status::OK)
+                return l_status;
+
+            // Install the new contents. When appending, they are moved in after
+            // this registry's own. Otherwise, they are swapped in, and the old
+            // ones are destroyed along with the temporary registry, after the
+            // lock is released.
+            {
+                WriteLock l_lock { m_mutex };
+
+                if (a_append == true)
+                    appendContents(*l_loaded);
+                else
+                    takeContents(*l_loaded);
+            }
+
+            return Status::OK;
+        });
+    }
+
+    std::future<Status> Registry::saveToFileAsync (const String &a_filename, const U8 a_format) const
+    {
+        std::shared_ptr<const Registry> l_snapshot { clone() };
+
+        return Executor::getDefault().submit([l_snapshot, a_filename, a_format] ()
+        {
+            return l_snapshot->saveToFile(a_filename, a_format);
+        });
+    }
+
+    std::unique_ptr<Registry> Registry::clone () const
+    {
+        std::unique_ptr<Registry> l_clone { new Registry() };
+        l_clone->shareContents(*this);
+        return l_clone;
+    }
+
+    Registry::ReadLock Registry::lockForReading () const
+    {
+        return ReadLock { m_mutex };
+    }
+
+    Registry::WriteLock Registry::lockForWriting ()
+    {
+        return WriteLock { m_mutex };
+    }
+
 }
@@ -0,0 +1,207 @@
+///
+/// \file   RegistryOverlay.cpp
+///
+
+#include <Nelobin/RegistryOverlay.hpp>
+
+namespace Nelobin
+{
+
+    RegistryOverlay::View::View (std::vector<const Key*> &&a_keys) :
+        m_keys  { std::move(a_keys) }
+    {
+
+    }
+
+    RegistryOverlay::View RegistryOverlay::View::getKey (const String &a_name, const U32 a_instance) const
+    {
+        std::vector<const Key*> l_keys(m_keys.size(), nullptr);
+
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == true)
+        {
+            for (Size i = 0; i < m_keys.size(); ++i)
+            {
+                if (m_keys[i] == nullptr)
+                    continue;
+
+                auto l_find = m_keys[i]->cseekKey(l_atom, a_instance);
+                if (l_find != m_keys[i]->m_keys.cend())
+                    l_keys[i] = l_find->get();
+            }
+        }
+
+        return View { std::move(l_keys) };
+    }
+
+    const Key* RegistryOverlay::View::getLayerKey (const Size a_layer) const
+    {
+        if (a_layer >= m_keys.size())
+            return nullptr;
+
+        return m_keys[m_keys.size() - 1 - a_layer];
+    }
+
+    Boolean RegistryOverlay::View::isEmpty () const
+    {
+        for (const Key* lp_key : m_keys)
+        {
+            if (lp_key != nullptr)
+                return false;
+        }
+
+        return true;
+    }
+
+    const EntryBase* RegistryOverlay::View::findEntry (const String &a_name) const
+    {
+        Atom l_atom;
+        if (Atom::probe(a_name, l_atom) == false)
+            return nullptr;
+
+        for (const Key* lp_key : m_keys)
+        {
+            if (lp_key == nullptr)
+                continue;
+
+            auto l_find = lp_key->cseekEntry(l_atom);
+            if (l_find != lp_key->m_entries.cend())
+                return l_find->get();
+        }
+
+        return nullptr;
+    }
+
+    RegistryOverlay::RegistryOverlay ()
+    {
+
+    }
+
+    RegistryOverlay::RegistryOverlay (std::initializer_list<const Registry*> a_layers)
+    {
+        for (const Registry* lp_layer : a_layers)
+            pushLayer(*lp_layer);
+    }
+
+    void RegistryOverlay::validate () const
+    {
+        for (Size i = 0; i < m_layers.size(); ++i)
+        {
+            if (m_layers[i]->getRevision() != m_revisions[i])
+            {
+                invalidate();
+                return;
+            }
+        }
+    }
+
+    const std::vector<const Key*>& RegistryOverlay::resolveKey (const String &a_path) const
+    {
+        auto l_find = m_keyCache.find(a_path);
+        if (l_find != m_keyCache.end())
+            return l_find->second;
+
+        // Start from the root key of each layer, top layer first.
+        std::vector<const Key*> l_keys(m_layers.rbegin(), m_layers.rend());
+
+        String l_name;
+        U32 l_instance = 0;
+        Size l_position = 0;
+
+        while (nextPathComponent(a_path, l_position, l_name, l_instance) == true)
+        {
+            Atom l_atom;
+            Boolean l_interned = Atom::probe(l_name, l_atom);
+
+            for (auto& lp_key : l_keys)
+            {
+                if (lp_key == nullptr)
+                    continue;
+
+                if (l_interned == false)
+                {
+                    lp_key = nullptr;
+                    continue;
+                }
+
+                auto l_child = lp_key->cseekKey(l_atom, l_instance);
+                lp_key = (l_child != lp_key->m_keys.cend()) ? l_child->get() : nullptr;
+            }
+        }
+
+        return m_keyCache.emplace(a_path, std::move(l_keys)).first->second;
+    }
+
+    const EntryBase* RegistryOverlay::resolveEntry (const String &a_path) const
+    {
+        validate();
+
+        auto l_find = m_entryCache.find(a_path);
+        if (l_find != m_entryCache.end())
+            return l_find->second;
+
+        // Split the path into the key's path and the entry's name.
+        Size l_slash = a_path.rfind('/');
+        String l_keyPath = (l_slash == String::npos) ? String {} : a_path.substr(0, l_slash);
+        String l_name = (l_slash == String::npos) ? a_path : a_path.substr(l_slash + 1);
+
+        const EntryBase* lp_entry = nullptr;
+
+        Atom l_atom;
+        if (Atom::probe(l_name, l_atom) == true)
+        {
+            for (const Key* lp_key : resolveKey(l_keyPath))
+            {
+                if (lp_key == nullptr)
+                    continue;
+
+                auto l_entry = lp_key->cseekEntry(l_atom);
+                if (l_entry != lp_key->m_entries.cend())
+                {
+                    lp_entry = l_entry->get();
+                    break;
+                }
+            }
+        }
+
+        m_entryCache.emplace(a_path, lp_entry);
+        return lp_entry;
+    }
+
+    void RegistryOverlay::pushLayer (const Registry &a_registry)
+    {
+        m_layers.push_back(&a_registry);
+        invalidate();
+    }
+
+    void RegistryOverlay::popLayer ()
+    {
+        if (m_layers.empty() == true)
+        {
+            _Nelobin_Error("RegistryOverlay::popLayer(): There are no layers to pop.");
+            return;
+        }
+
+        m_layers.pop_back();
+        invalidate();
+    }
+
+    RegistryOverlay::View RegistryOverlay::getKey (const String &a_path) const
+    {
+        validate();
+
+        std::vector<const Key*> l_keys = resolveKey(a_path);
+        return View { std::move(l_keys) };
+    }
+
+    void RegistryOverlay::invalidate () const
+    {
+        m_keyCache.clear();
+        m_entryCache.clear();
+
+        m_revisions.resize(m_layers.size());
+        for (Size i = 0; i < m_layers.size(); ++i)
+            m_revisions[i] = m_layers[i]->getRevision();
+    }
+
+}
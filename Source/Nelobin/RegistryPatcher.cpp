@@ -0,0 +1,343 @@
+///
+/// \file   RegistryPatcher.cpp
+///
+
+#include <Nelobin/Order.hpp>
+#include <Nelobin/RegistryPatcher.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        ///
+        /// \fn     getFixedWidth
+        /// \brief  Gets the number of bytes taken by a fixed-width value in the standard layout.
+        ///
+        /// \return The value's width, or zero for strings and unknown types.
+        ///
+        static Size getFixedWidth (const U8 a_alias)
+        {
+            switch (a_alias)
+            {
+            case Datatypes::SignedByte:
+            case Datatypes::UnsignedByte:       return 1;
+            case Datatypes::SignedShort:
+            case Datatypes::UnsignedShort:      return 2;
+            case Datatypes::SignedInteger:
+            case Datatypes::UnsignedInteger:
+            case Datatypes::FloatingPoint:      return 4;
+            default:                            return 0;
+            }
+        }
+
+        ///
+        /// \class  PatchScanner
+        /// \brief  Walks a registry file in the standard layout, noting where each fixed-width value is stored.
+        ///
+        class PatchScanner
+        {
+        private:
+            const char*     mp_data;        ///< The start of the file.
+            Size            m_size;         ///< The size of the file.
+            Size            m_read;         ///< The read position.
+
+        public:
+            PatchScanner (const char* ap_data,
+                          const Size a_size) :
+                mp_data     { ap_data },
+                m_size      { a_size },
+                m_read      { 0 }
+            {}
+
+        public:
+            inline Boolean canRead (const Size a_size) const
+            {
+                return a_size <= m_size - m_read;
+            }
+
+            inline Boolean readU8 (U8& a_value)
+            {
+                if (canRead(1) == false)
+                    return false;
+
+                a_value = static_cast<U8>(mp_data[m_read++]);
+                return true;
+            }
+
+            inline Boolean readU16 (U16& a_value)
+            {
+                if (canRead(sizeof(a_value)) == false)
+                    return false;
+
+                std::memcpy(&a_value, mp_data + m_read, sizeof(a_value));
+                a_value = swapBytes<U16>(a_value);
+                m_read += sizeof(a_value);
+                return true;
+            }
+
+            inline Boolean readU32 (U32& a_value)
+            {
+                if (canRead(sizeof(a_value)) == false)
+                    return false;
+
+                std::memcpy(&a_value, mp_data + m_read, sizeof(a_value));
+                a_value = swapBytes<U32>(a_value);
+                m_read += sizeof(a_value);
+                return true;
+            }
+
+            inline Boolean readString (String& a_value)
+            {
+                U32 l_length = 0;
+                if (readU32(l_length) == false || canRead(l_length) == false)
+                    return false;
+
+                a_value.assign(mp_data + m_read, l_length);
+                m_read += l_length;
+                return true;
+            }
+
+            inline Boolean skip (const Size a_size)
+            {
+                if (canRead(a_size) == false)
+                    return false;
+
+                m_read += a_size;
+                return true;
+            }
+
+            ///
+            /// \fn     scanKey
+            /// \brief  Scans the given number of entities, belonging to the key at the given path.
+            ///
+            /// \param  a_prefix    The key's canonical path, ending with a slash, or empty for the root key.
+            /// \param  a_count     The number of entities in the key.
+            /// \param  a_slots     Filled with the values found.
+            /// \param  a_depth     How deeply the key is nested. Files nesting keys
+            ///                     deeper than 'G_MAX_KEY_DEPTH' are rejected.
+            ///
+            template <typename Slots>
+            Boolean scanKey (const String& a_prefix,
+                             const U32 a_count,
+                             Slots& a_slots,
+                             const U32 a_depth = 0)
+            {
+                if (a_depth > G_MAX_KEY_DEPTH)
+                    return false;
+
+                // Subkeys are numbered in the order they are found, per name.
+                std::unordered_map<String, U32> l_instances;
+                String l_name;
+
+                for (U32 i = 0; i < a_count; ++i)
+                {
+                    U32 l_header = 0;
+                    if (readU32(l_header) == false || readString(l_name) == false || l_name.empty() == true)
+                        return false;
+
+                    if (l_header == G_ENTRY_HEADER)
+                    {
+                        U8 l_alias = 0;
+                        if (readU8(l_alias) == false)
+                            return false;
+
+                        if (l_alias == Datatypes::StringLiteral)
+                        {
+                            U32 l_length = 0;
+                            if (readU32(l_length) == false || skip(l_length) == false)
+                                return false;
+
+                            continue;
+                        }
+
+                        const Size l_width = getFixedWidth(l_alias);
+                        if (l_width == 0)
+                            return false;
+
+                        // As when the file is loaded, a repeated entry overwrites the
+                        // first one's value, unless it is of another type.
+                        auto l_insert = a_slots.emplace(a_prefix + l_name, typename Slots::mapped_type { m_read, l_alias });
+                        if (l_insert.second == false && l_insert.first->second.m_alias == l_alias)
+                            l_insert.first->second.m_offset = m_read;
+
+                        if (skip(l_width) == false)
+                            return false;
+                    }
+                    else if (l_header == G_KEY_HEADER)
+                    {
+                        U32 l_count = 0;
+                        if (readU32(l_count) == false)
+                            return false;
+
+                        U32 l_instance = l_instances[l_name]++;
+                        if (scanKey(a_prefix + l_name + ":" + std::to_string(l_instance) + "/", l_count, a_slots, a_depth + 1) == false)
+                            return false;
+                    }
+                    else
+                        return false;
+                }
+
+                return true;
+            }
+
+        };
+
+        ///
+        /// \fn     canonicalizePath
+        /// \brief  Rewrites a path to an entry with an explicit instance ID for every key.
+        ///
+        static String canonicalizePath (const String& a_path)
+        {
+            Size l_slash = a_path.rfind('/');
+            if (l_slash == String::npos)
+                return a_path;
+
+            String l_canonical;
+            String l_name;
+            U32 l_instance = 0;
+            Size l_position = 0;
+
+            const String l_keyPath = a_path.substr(0, l_slash);
+            while (nextPathComponent(l_keyPath, l_position, l_name, l_instance) == true)
+                l_canonical.append(l_name).append(":").append(std::to_string(l_instance)).append("/");
+
+            return l_canonical.append(a_path, l_slash + 1, String::npos);
+        }
+
+    }
+
+    RegistryPatcher::RegistryPatcher ()
+    {
+
+    }
+
+    Status RegistryPatcher::open (const String &a_filename)
+    {
+        close();
+
+        Status l_status = m_file.open(a_filename, true);
+        if (l_status != Status::OK)
+            return l_status;
+
+        Private::PatchScanner l_scanner { m_file.getData(), m_file.getSize() };
+
+        U32 l_header = 0, l_count = 0;
+        U16 l_version = 0;
+
+        if (l_scanner.readU32(l_header) == false || l_header != G_REGISTRY_HEADER ||
+            l_scanner.readU16(l_version) == false)
+        {
+            _Nelobin_Error("RegistryPatcher::open(): \"" << a_filename << "\" is not a registry file.");
+            close();
+            return Status::FileParseError;
+        }
+
+        if (l_version != G_VERSION)
+        {
+            _Nelobin_Error("RegistryPatcher::open(): \"" << a_filename << "\" is not in the standard layout, so it can't be patched.");
+            close();
+            return Status::FileParseError;
+        }
+
+        if (l_scanner.readU32(l_count) == false || l_scanner.scanKey("", l_count, m_slots) == false)
+        {
+            _Nelobin_Error("RegistryPatcher::open(): Error parsing registry file \"" << a_filename << "\".");
+            close();
+            return Status::FileParseError;
+        }
+
+        return Status::OK;
+    }
+
+    void RegistryPatcher::close ()
+    {
+        m_slots.clear();
+        m_file.close();
+    }
+
+    Status RegistryPatcher::findSlot (const String &a_path, const U8 a_alias, Size &a_offset) const
+    {
+        auto l_find = m_slots.find(Private::canonicalizePath(a_path));
+        if (l_find == m_slots.end())
+        {
+            _Nelobin_Error("RegistryPatcher: Fixed-width entry, \"" << a_path << "\", not found.");
+            return Status::NotFound;
+        }
+
+        if (l_find->second.m_alias != a_alias)
+        {
+            _Nelobin_Error("RegistryPatcher: Entry, \"" << a_path << "\", was found, but a type mismatch occured.");
+            return Status::TypeMismatch;
+        }
+
+        a_offset = l_find->second.m_offset;
+        return Status::OK;
+    }
+
+    Status RegistryPatcher::write (const String &a_path, const U8 a_alias, const U32 a_bits, const Boolean a_sync)
+    {
+        Size l_offset = 0;
+        Status l_status = findSlot(a_path, a_alias, l_offset);
+        if (l_status != Status::OK)
+            return l_status;
+
+        // Encode the value in the file's byte order.
+        char* lp_value = m_file.getData() + l_offset;
+        const Size l_width = Private::getFixedWidth(a_alias);
+
+        if (l_width == 1)
+            *lp_value = static_cast<char>(a_bits);
+        else if (l_width == 2)
+        {
+            const U16 l_value = swapBytes<U16>(static_cast<U16>(a_bits));
+            std::memcpy(lp_value, &l_value, sizeof(l_value));
+        }
+        else
+        {
+            const U32 l_value = swapBytes<U32>(a_bits);
+            std::memcpy(lp_value, &l_value, sizeof(l_value));
+        }
+
+        return (a_sync == true) ? m_file.sync(l_offset, l_width) : Status::OK;
+    }
+
+    Status RegistryPatcher::read (const String &a_path, const U8 a_alias, U32 &a_bits) const
+    {
+        Size l_offset = 0;
+        Status l_status = findSlot(a_path, a_alias, l_offset);
+        if (l_status != Status::OK)
+            return l_status;
+
+        const char* lp_value = m_file.getData() + l_offset;
+        const Size l_width = Private::getFixedWidth(a_alias);
+
+        // Sign-extend signed values, so that narrowing them restores them.
+        if (l_width == 1)
+            a_bits = (a_alias == Datatypes::SignedByte) ? static_cast<U32>(static_cast<S8>(*lp_value))
+                                                        : static_cast<U32>(static_cast<U8>(*lp_value));
+        else if (l_width == 2)
+        {
+            U16 l_value = 0;
+            std::memcpy(&l_value, lp_value, sizeof(l_value));
+            l_value = swapBytes<U16>(l_value);
+            a_bits = (a_alias == Datatypes::SignedShort) ? static_cast<U32>(static_cast<S16>(l_value)) : l_value;
+        }
+        else
+        {
+            std::memcpy(&a_bits, lp_value, sizeof(a_bits));
+            a_bits = swapBytes<U32>(a_bits);
+        }
+
+        return Status::OK;
+    }
+
+    Status RegistryPatcher::sync ()
+    {
+        if (m_file.isOpen() == false)
+            return Status::FileSaveError;
+
+        return m_file.sync(0, m_file.getSize());
+    }
+
+}
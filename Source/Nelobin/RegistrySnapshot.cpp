@@ -0,0 +1,101 @@
+///
+/// \file   RegistrySnapshot.cpp
+///
+
+#include <thread>
+#include <Nelobin/RegistrySnapshot.hpp>
+
+namespace Nelobin
+{
+
+    RegistrySnapshot::Reader::Reader (const RegistrySnapshot *ap_snapshot,
+                                      const U32 a_slot,
+                                      const Registry *ap_registry) :
+        mp_snapshot { ap_snapshot },
+        m_slot      { a_slot },
+        mp_registry { ap_registry }
+    {
+
+    }
+
+    RegistrySnapshot::Reader::Reader (Reader &&a_other) :
+        mp_snapshot { a_other.mp_snapshot },
+        m_slot      { a_other.m_slot },
+        mp_registry { a_other.mp_registry }
+    {
+        a_other.mp_snapshot = nullptr;
+        a_other.mp_registry = nullptr;
+    }
+
+    RegistrySnapshot::Reader::~Reader ()
+    {
+        if (mp_snapshot != nullptr)
+            mp_snapshot->m_readers[m_slot].fetch_sub(1, std::memory_order_release);
+    }
+
+    RegistrySnapshot::RegistrySnapshot () :
+        mp_current  { nullptr },
+        m_epoch     { 0 }
+    {
+        m_readers[0].store(0, std::memory_order_relaxed);
+        m_readers[1].store(0, std::memory_order_relaxed);
+    }
+
+    RegistrySnapshot::~RegistrySnapshot ()
+    {
+        delete mp_current.load(std::memory_order_acquire);
+    }
+
+    RegistrySnapshot::Reader RegistrySnapshot::read () const
+    {
+        // Register under the current epoch's parity. If the epoch moved on while
+        // we registered, a publisher may already have stopped waiting on that
+        // counter, so back out and try again.
+        while (true)
+        {
+            const U32 l_epoch = m_epoch.load(std::memory_order_seq_cst);
+            const U32 l_slot = l_epoch & 1;
+
+            m_readers[l_slot].fetch_add(1, std::memory_order_seq_cst);
+
+            if (m_epoch.load(std::memory_order_seq_cst) == l_epoch)
+                return Reader { this, l_slot, mp_current.load(std::memory_order_seq_cst) };
+
+            m_readers[l_slot].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void RegistrySnapshot::publish (std::unique_ptr<Registry> a_registry)
+    {
+        std::lock_guard<std::mutex> l_lock { m_publishMutex };
+
+        // Swap in the new version. Readers registering from here on will see it.
+        const Registry* lp_old = mp_current.exchange(a_registry.release(), std::memory_order_seq_cst);
+
+        // Advance the epoch, then wait for readers registered under the old
+        // epoch, who may still be reading the old version, to let go.
+        const U32 l_epoch = m_epoch.load(std::memory_order_relaxed);
+        m_epoch.store(l_epoch + 1, std::memory_order_seq_cst);
+
+        while (m_readers[l_epoch & 1].load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+
+        delete lp_old;
+    }
+
+    Status RegistrySnapshot::reload (const String &a_filename)
+    {
+        std::unique_ptr<Registry> l_registry { new Registry() };
+
+        Status l_status = l_registry->loadFromFile(a_filename);
+        if (l_status != Status::OK)
+        {
+            _Nelobin_Error("RegistrySnapshot::reload(): Error loading \"" << a_filename << "\". Keeping the current registry.");
+            return l_status;
+        }
+
+        publish(std::move(l_registry));
+        return Status::OK;
+    }
+
+}
@@ -0,0 +1,310 @@
+///
+/// \file   Text.cpp
+///
+
+#include <cerrno>
+#include <charconv>
+#include <ostream>
+#include <Nelobin/Text.hpp>
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+# include <unistd.h>
+#else
+# include <io.h>
+#endif
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        /// The size at which dumped text is written out.
+        const Size G_TEXT_CHUNK_SIZE = 64 * 1024;
+
+        /// Writes a chunk of dumped text somewhere. Returns false if it fails.
+        using TextSink = Boolean (*) (const char* ap_data, const Size a_size, void* ap_userData);
+
+        ///
+        /// \fn     appendNumber
+        /// \brief  Appends a number to a string, with 'std::to_chars'.
+        ///
+        template <typename T>
+        static inline void appendNumber (String& a_text, const T a_value)
+        {
+            // Large enough for any 32-bit integer or shortest-form float.
+            char l_digits[32];
+            auto l_result = std::to_chars(l_digits, l_digits + sizeof(l_digits), a_value);
+            a_text.append(l_digits, l_result.ptr);
+        }
+
+        ///
+        /// \fn     flushText
+        /// \brief  Writes the dumped text out, if the chunk has filled.
+        ///
+        /// \return False if the sink failed.
+        ///
+        static inline Boolean flushText (String& a_text, TextSink ap_sink, void* ap_userData)
+        {
+            if (a_text.size() < G_TEXT_CHUNK_SIZE)
+                return true;
+
+            if (ap_sink(a_text.data(), a_text.size(), ap_userData) == false)
+                return false;
+
+            a_text.clear();
+            return true;
+        }
+
+        ///
+        /// \fn     dumpKeyText
+        /// \brief  Dumps the contents of a key at the given depth, writing the text
+        ///         out whenever the chunk fills.
+        ///
+        /// \return False if the sink failed.
+        ///
+        static Boolean dumpKeyText (const Key& a_key, const Size a_depth, String& a_text,
+                                    TextSink ap_sink, void* ap_userData)
+        {
+            for (Size i = 0; i < a_key.getEntryCount(); ++i)
+            {
+                const EntryBase& l_entry = a_key.getEntryBaseAt(i);
+
+                a_text.append(a_depth * 4, ' ');
+                a_text.append(l_entry.getName());
+                a_text.append(" (");
+                a_text.append(getShortTypeName(l_entry.getAlias()));
+                a_text.append(") = ");
+
+                if (l_entry.getAlias() == Datatypes::StringLiteral)
+                {
+                    const String& l_value = static_cast<const Entry<String>&>(l_entry).get();
+                    appendQuoted(a_text, l_value.data(), l_value.size());
+                }
+                else
+                    appendEntry(a_text, l_entry);
+
+                a_text.push_back('\n');
+
+                if (flushText(a_text, ap_sink, ap_userData) == false)
+                    return false;
+            }
+
+            for (Size i = 0; i < a_key.getKeyCount(); ++i)
+            {
+                const Key& l_key = a_key.getKey(i);
+
+                a_text.append(a_depth * 4, ' ');
+                a_text.push_back('[');
+                a_text.append(l_key.getName());
+
+                if (l_key.getInstanceID() != 0)
+                {
+                    a_text.push_back(':');
+                    appendNumber(a_text, l_key.getInstanceID());
+                }
+
+                a_text.append("]\n");
+
+                if (flushText(a_text, ap_sink, ap_userData) == false ||
+                    dumpKeyText(l_key, a_depth + 1, a_text, ap_sink, ap_userData) == false)
+                    return false;
+            }
+
+            return true;
+        }
+
+        ///
+        /// \fn     dumpText
+        /// \brief  Dumps a key, writing its text to the given sink in chunks.
+        ///
+        static Boolean dumpText (const Key& a_key, TextSink ap_sink, void* ap_userData)
+        {
+            String l_text;
+            l_text.reserve(G_TEXT_CHUNK_SIZE + 1024);
+
+            // The root's contents are written unindented. Any other key's contents
+            // are indented beneath a line naming it.
+            Size l_depth = 0;
+            if (a_key.getName() != "root")
+            {
+                l_text.push_back('[');
+                l_text.append(a_key.getName());
+
+                if (a_key.getInstanceID() != 0)
+                {
+                    l_text.push_back(':');
+                    appendNumber(l_text, a_key.getInstanceID());
+                }
+
+                l_text.append("]\n");
+                l_depth = 1;
+            }
+
+            if (dumpKeyText(a_key, l_depth, l_text, ap_sink, ap_userData) == false)
+                return false;
+
+            return l_text.empty() == true || ap_sink(l_text.data(), l_text.size(), ap_userData) == true;
+        }
+
+    }
+
+    void appendValue (String &a_text, const S8 a_value)
+    {
+        Private::appendNumber(a_text, static_cast<int>(a_value));
+    }
+
+    void appendValue (String &a_text, const S16 a_value)
+    {
+        Private::appendNumber(a_text, static_cast<int>(a_value));
+    }
+
+    void appendValue (String &a_text, const S32 a_value)
+    {
+        Private::appendNumber(a_text, a_value);
+    }
+
+    void appendValue (String &a_text, const U8 a_value)
+    {
+        Private::appendNumber(a_text, static_cast<unsigned>(a_value));
+    }
+
+    void appendValue (String &a_text, const U16 a_value)
+    {
+        Private::appendNumber(a_text, static_cast<unsigned>(a_value));
+    }
+
+    void appendValue (String &a_text, const U32 a_value)
+    {
+        Private::appendNumber(a_text, a_value);
+    }
+
+    void appendValue (String &a_text, const Float a_value)
+    {
+        Private::appendNumber(a_text, a_value);
+    }
+
+    void appendQuoted (String &a_text, const char *ap_data, const Size a_length)
+    {
+        static const char s_hex[] = "0123456789abcdef";
+
+        a_text.push_back('"');
+        for (Size i = 0; i < a_length; ++i)
+        {
+            const char l_char = ap_data[i];
+            switch (l_char)
+            {
+            case '"':   a_text.append("\\\""); break;
+            case '\\':  a_text.append("\\\\"); break;
+            case '\n':  a_text.append("\\n"); break;
+            case '\r':  a_text.append("\\r"); break;
+            case '\t':  a_text.append("\\t"); break;
+            default:
+                if (static_cast<U8>(l_char) < 0x20 || l_char == 0x7F)
+                {
+                    const char l_escape[4] = { '\\', 'x', s_hex[static_cast<U8>(l_char) >> 4],
+                                               s_hex[static_cast<U8>(l_char) & 0xF] };
+                    a_text.append(l_escape, sizeof(l_escape));
+                }
+                else
+                    a_text.push_back(l_char);
+            }
+        }
+        a_text.push_back('"');
+    }
+
+    const char* getShortTypeName (const U8 a_alias)
+    {
+        switch (a_alias)
+        {
+        case Datatypes::SignedByte:         return "S8";
+        case Datatypes::SignedShort:        return "S16";
+        case Datatypes::SignedInteger:      return "S32";
+        case Datatypes::UnsignedByte:       return "U8";
+        case Datatypes::UnsignedShort:      return "U16";
+        case Datatypes::UnsignedInteger:    return "U32";
+        case Datatypes::FloatingPoint:      return "Float";
+        case Datatypes::StringLiteral:      return "String";
+        default:                            return "Unknown";
+        }
+    }
+
+    void appendEntry (String &a_text, const EntryBase &a_entry)
+    {
+        #define _Nelobin_Append_Entry(a_type) \
+            appendValue(a_text, static_cast<const Entry<a_type>&>(a_entry).get()); break;
+
+        switch (a_entry.getAlias())
+        {
+        case Datatypes::SignedByte:         _Nelobin_Append_Entry(S8)
+        case Datatypes::SignedShort:        _Nelobin_Append_Entry(S16)
+        case Datatypes::SignedInteger:      _Nelobin_Append_Entry(S32)
+        case Datatypes::UnsignedByte:       _Nelobin_Append_Entry(U8)
+        case Datatypes::UnsignedShort:      _Nelobin_Append_Entry(U16)
+        case Datatypes::UnsignedInteger:    _Nelobin_Append_Entry(U32)
+        case Datatypes::FloatingPoint:      _Nelobin_Append_Entry(Float)
+        case Datatypes::StringLiteral:
+            a_text.append(static_cast<const Entry<String>&>(a_entry).get());
+            break;
+        default:
+            break;
+        }
+
+        #undef _Nelobin_Append_Entry
+    }
+
+    Status dumpText (const Key &a_key, std::ostream &a_stream)
+    {
+        auto l_sink = [] (const char* ap_data, const Size a_size, void* ap_userData) -> Boolean
+        {
+            std::ostream& l_stream = *static_cast<std::ostream*>(ap_userData);
+            l_stream.write(ap_data, static_cast<std::streamsize>(a_size));
+            return l_stream.good();
+        };
+
+        if (Private::dumpText(a_key, l_sink, &a_stream) == false)
+        {
+            _Nelobin_Error("dumpText(): Error writing to the stream.");
+            return Status::FileSaveError;
+        }
+
+        return Status::OK;
+    }
+
+    Status dumpText (const Key &a_key, const int a_descriptor)
+    {
+        auto l_sink = [] (const char* ap_data, const Size a_size, void* ap_userData) -> Boolean
+        {
+            const int l_descriptor = *static_cast<const int*>(ap_userData);
+            Size l_written = 0;
+
+            // Writes to pipes and sockets may be cut short, or interrupted.
+            while (l_written < a_size)
+            {
+#if !defined(_WINDOWS) && !defined(_WIN32)
+                auto l_result = ::write(l_descriptor, ap_data + l_written, a_size - l_written);
+#else
+                auto l_result = ::_write(l_descriptor, ap_data + l_written,
+                                         static_cast<unsigned>(a_size - l_written));
+#endif
+                if (l_result < 0 && errno == EINTR)
+                    continue;
+                else if (l_result <= 0)
+                    return false;
+
+                l_written += static_cast<Size>(l_result);
+            }
+
+            return true;
+        };
+
+        int l_descriptor = a_descriptor;
+        if (Private::dumpText(a_key, l_sink, &l_descriptor) == false)
+        {
+            _Nelobin_Error("dumpText(): Error writing to file descriptor " << a_descriptor << ".");
+            return Status::FileSaveError;
+        }
+
+        return Status::OK;
+    }
+
+}
@@ -0,0 +1,248 @@
+///
+/// \file   Tracing.cpp
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Nelobin/Tracing.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        std::atomic<Boolean> G_TRACING { false };
+
+        ///
+        /// \struct TraceEvent
+        /// \brief  A finished span.
+        ///
+        struct TraceEvent
+        {
+            const char*     mp_name;        ///< The span's name.
+            Atom            m_detail;       ///< The span's optional detail name.
+            U64             m_start;        ///< When the span started, in nanoseconds since tracing began.
+            U64             m_duration;     ///< How long the span lasted, in nanoseconds.
+        };
+
+        ///
+        /// \struct TraceThread
+        /// \brief  The spans recorded by one thread.
+        ///
+        /// Each thread records into its own list, so threads only contend when the
+        /// trace is cleared or saved. The lists outlive their threads, so that the
+        /// spans of finished threads can still be saved.
+        ///
+        struct TraceThread
+        {
+            std::mutex                  m_mutex;        ///< Guards the list of events.
+            std::vector<TraceEvent>     m_events;       ///< The spans recorded so far.
+            U32                         m_id = 0;       ///< The thread's ID in the trace.
+            U32                         m_keys = 0;     ///< The number of key spans seen, for sampling.
+        };
+
+        static std::mutex                                   s_traceMutex;
+        static std::vector<std::shared_ptr<TraceThread>>    s_traceThreads;
+        static U32                                          s_traceNextID = 1;
+        static std::atomic<U32>                             s_traceSampling { 1 };
+        static std::atomic<U64>                             s_traceEpoch { 0 };
+
+        ///
+        /// \fn     getTraceThread
+        /// \brief  Gets the calling thread's list of spans, registering it the first time.
+        ///
+        static TraceThread& getTraceThread ()
+        {
+            thread_local std::shared_ptr<TraceThread> tl_thread;
+
+            if (tl_thread == nullptr)
+            {
+                tl_thread = std::make_shared<TraceThread>();
+
+                std::lock_guard<std::mutex> l_lock { s_traceMutex };
+                tl_thread->m_id = s_traceNextID++;
+                s_traceThreads.push_back(tl_thread);
+            }
+
+            return *tl_thread;
+        }
+
+        ///
+        /// \fn     getClockTime
+        /// \brief  Gets the time on the steady clock, in nanoseconds.
+        ///
+        static U64 getClockTime ()
+        {
+            auto l_time = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(l_time).count());
+        }
+
+        ///
+        /// \fn     getTraceTime
+        /// \brief  Gets the time since tracing began, in nanoseconds.
+        ///
+        static U64 getTraceTime ()
+        {
+            return getClockTime() - s_traceEpoch.load(std::memory_order_relaxed);
+        }
+
+        ///
+        /// \fn     writeJsonString
+        /// \brief  Writes a string to a JSON document, quoted and escaped.
+        ///
+        static void writeJsonString (std::ostream& a_stream,
+                                     const String& a_string)
+        {
+            a_stream << '"';
+            for (const char l_char : a_string)
+            {
+                if (l_char == '"' || l_char == '\\')
+                    a_stream << '\\' << l_char;
+                else if (static_cast<U8>(l_char) < 0x20)
+                {
+                    char l_escape[8];
+                    std::snprintf(l_escape, sizeof(l_escape), "\\u%04x", static_cast<unsigned>(l_char));
+                    a_stream << l_escape;
+                }
+                else
+                    a_stream << l_char;
+            }
+            a_stream << '"';
+        }
+
+        Boolean beginTraceSpan (const Boolean a_key, U64 &a_start)
+        {
+            if (a_key == true)
+            {
+                const U32 l_sampling = s_traceSampling.load(std::memory_order_relaxed);
+                if (l_sampling == 0 || getTraceThread().m_keys++ % l_sampling != 0)
+                    return false;
+            }
+
+            a_start = getTraceTime();
+            return true;
+        }
+
+        void endTraceSpan (const char *ap_name, const Atom &a_detail, const U64 a_start)
+        {
+            // Drop spans which straddle a restart of the trace.
+            const U64 l_end = getTraceTime();
+            if (l_end < a_start)
+                return;
+
+            TraceThread& l_thread = getTraceThread();
+
+            std::lock_guard<std::mutex> l_lock { l_thread.m_mutex };
+            l_thread.m_events.push_back({ ap_name, a_detail, a_start, l_end - a_start });
+        }
+
+    }
+
+    void startTracing (const U32 a_keySampling)
+    {
+        std::lock_guard<std::mutex> l_lock { Private::s_traceMutex };
+
+        // Forget the threads which have finished, and clear the rest.
+        auto& l_threads = Private::s_traceThreads;
+        l_threads.erase(std::remove_if(l_threads.begin(), l_threads.end(),
+                                       [] (const std::shared_ptr<Private::TraceThread>& a_thread)
+        {
+            return a_thread.use_count() == 1;
+        }), l_threads.end());
+
+        for (auto& l_thread : l_threads)
+        {
+            std::lock_guard<std::mutex> l_threadLock { l_thread->m_mutex };
+            l_thread->m_events.clear();
+        }
+
+        Private::s_traceEpoch.store(Private::getClockTime(), std::memory_order_relaxed);
+        Private::s_traceSampling.store(a_keySampling, std::memory_order_relaxed);
+        Private::G_TRACING.store(true, std::memory_order_release);
+    }
+
+    void stopTracing ()
+    {
+        Private::G_TRACING.store(false, std::memory_order_release);
+    }
+
+    Status saveTrace (const String &a_filename)
+    {
+        if (a_filename.empty() == true)
+        {
+            _Nelobin_Error("saveTrace(): No filename specified.");
+            return Status::NoName;
+        }
+
+        std::ofstream l_file { a_filename, std::ios::out | std::ios::trunc };
+        if (l_file.is_open() == false)
+        {
+            _Nelobin_Error("saveTrace(): Could not open \"" << a_filename << "\" for writing.");
+            return Status::FileSaveError;
+        }
+
+        // Complete ("X") events nest by time on each thread, so no begin and end
+        // pairs are needed. Times are in microseconds.
+        l_file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        Boolean l_first = true;
+        char l_times[64];
+
+        std::lock_guard<std::mutex> l_lock { Private::s_traceMutex };
+        for (auto& l_thread : Private::s_traceThreads)
+        {
+            std::lock_guard<std::mutex> l_threadLock { l_thread->m_mutex };
+
+            l_file << (l_first ? "\n" : ",\n")
+                   << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << l_thread->m_id
+                   << ",\"args\":{\"name\":\"Thread " << l_thread->m_id << "\"}}";
+            l_first = false;
+
+            for (const auto& l_event : l_thread->m_events)
+            {
+                std::snprintf(l_times, sizeof(l_times), "\"ts\":%.3f,\"dur\":%.3f",
+                              l_event.m_start / 1000.0, l_event.m_duration / 1000.0);
+
+                l_file << ",\n{\"name\":\"" << l_event.mp_name << "\",\"cat\":\"nelobin\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                       << l_thread->m_id << "," << l_times;
+
+                if (l_event.m_detail.isEmpty() == false)
+                {
+                    l_file << ",\"args\":{\"name\":";
+                    Private::writeJsonString(l_file, l_event.m_detail.getString());
+                    l_file << "}";
+                }
+
+                l_file << "}";
+            }
+        }
+
+        l_file << "\n]}\n";
+        if (l_file.good() == false)
+        {
+            _Nelobin_Error("saveTrace(): Error writing \"" << a_filename << "\".");
+            return Status::FileSaveError;
+        }
+
+        return Status::OK;
+    }
+
+    Boolean isTracing ()
+    {
+        return Private::G_TRACING.load(std::memory_order_relaxed);
+    }
+
+    Boolean isTracingAvailable ()
+    {
+#if defined(NELOBIN_TRACING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+}
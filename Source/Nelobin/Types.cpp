@@ -2,6 +2,8 @@
 /// \file   Types.cpp
 ///
 
+#include <cctype>
+#include <cstdlib>
 #include <Nelobin/Types.hpp>
 
 namespace Nelobin
@@ -24,4 +26,40 @@ namespace Nelobin
         }
     }
 
+    Boolean nextPathComponent (const String &a_path, Size &a_position, String &a_name, U32 &a_instance)
+    {
+        // Skip empty components.
+        while (a_position < a_path.size() && a_path[a_position] == '/')
+            a_position++;
+
+        if (a_position >= a_path.size())
+            return false;
+
+        Size l_begin = a_position;
+        Size l_end = a_path.find('/', l_begin);
+        if (l_end == String::npos)
+            l_end = a_path.size();
+
+        a_position = l_end;
+        a_instance = 0;
+
+        // An instance ID follows the last colon, if what follows it is a number.
+        Size l_colon = a_path.rfind(':', l_end - 1);
+        if (l_colon != String::npos && l_colon >= l_begin && l_colon + 1 < l_end)
+        {
+            char* lp_stop = nullptr;
+            unsigned long l_instance = std::strtoul(a_path.c_str() + l_colon + 1, &lp_stop, 10);
+
+            if (lp_stop == a_path.c_str() + l_end && std::isdigit(static_cast<unsigned char>(a_path[l_colon + 1])) != 0)
+            {
+                a_name.assign(a_path, l_begin, l_colon - l_begin);
+                a_instance = static_cast<U32>(l_instance);
+                return true;
+            }
+        }
+
+        a_name.assign(a_path, l_begin, l_end - l_begin);
+        return true;
+    }
+
 }
@@ -0,0 +1,745 @@
+///
+/// \file   Validator.cpp
+///
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Nelobin/Validator.hpp>
+
+namespace Nelobin
+{
+    namespace Private
+    {
+
+        ///
+        /// \struct NameSlice
+        /// \brief  A name in a file's name table, pointing into the file's bytes.
+        ///
+        struct NameSlice
+        {
+            const U8*   mp_bytes;       ///< The name's first byte.
+            U32         m_length;       ///< The name's length, in bytes.
+        };
+
+        ///
+        /// \fn     extendInteger
+        /// \brief  Truncates an integer's bits to the width of its type, then widens
+        ///         them back to 32 bits, sign-extending signed types.
+        ///
+        static inline U32 extendInteger (const U8 a_alias,
+                                         const U32 a_bits)
+        {
+            switch (a_alias)
+            {
+            case Datatypes::SignedByte:     return static_cast<U32>(static_cast<S32>(static_cast<S8>(a_bits)));
+            case Datatypes::SignedShort:    return static_cast<U32>(static_cast<S32>(static_cast<S16>(a_bits)));
+            case Datatypes::UnsignedByte:   return a_bits & 0xFF;
+            case Datatypes::UnsignedShort:  return a_bits & 0xFFFF;
+            default:                        return a_bits;
+            }
+        }
+
+        ///
+        /// \class  Scanner
+        /// \brief  Walks the bytes of a registry file, checking each field as it goes.
+        ///
+        /// Each field is read exactly as the buffer reads it, so that a file which
+        /// passes is consumed by the parser field for field. Each method returns
+        /// false, and records why, if the field is malformed or runs past the end.
+        ///
+        class Scanner
+        {
+        private:
+            const U8*       mp_start;       ///< The first byte of the file.
+            const U8*       mp_cursor;      ///< The next byte to be read.
+            const U8*       mp_end;         ///< One past the last byte of the file.
+            Boolean         m_compact;      ///< Are integers and headers written in the compact layout?
+            Boolean         m_nameTable;    ///< Are names written as indices into a name table?
+            U32             m_nameCount;    ///< The number of names in the name table.
+            const NameSlice* mp_names;      ///< The names in the name table, if they are wanted.
+            const char*     mp_error;       ///< Why the file failed, or null.
+            Size            m_errorOffset;  ///< Where the file failed.
+            Boolean         m_stopped;      ///< Did a visitor stop the walk?
+
+        public:
+            Scanner (const void* ap_data,
+                     const Size a_size) :
+                mp_start        { static_cast<const U8*>(ap_data) },
+                mp_cursor       { static_cast<const U8*>(ap_data) },
+                mp_end          { static_cast<const U8*>(ap_data) + a_size },
+                m_compact       { false },
+                m_nameTable     { false },
+                m_nameCount     { 0 },
+                mp_names        { nullptr },
+                mp_error        { nullptr },
+                m_errorOffset   { 0 },
+                m_stopped       { false }
+            {}
+
+        public:
+            inline Size getRemaining () const { return static_cast<Size>(mp_end - mp_cursor); }
+            inline Size getOffset () const { return static_cast<Size>(mp_cursor - mp_start); }
+            inline const char* getError () const { return mp_error; }
+            inline Size getErrorOffset () const { return m_errorOffset; }
+            inline Boolean hasNameTable () const { return m_nameTable; }
+            inline Boolean isStopped () const { return m_stopped; }
+
+            inline void setFormat (const U8 a_format)
+            {
+                m_compact = (a_format & Formats::Compact) != 0;
+                m_nameTable = (a_format & Formats::NameTable) != 0;
+            }
+
+            inline void setNameCount (const U32 a_count) { m_nameCount = a_count; }
+            inline void setNames (const NameSlice* ap_names) { mp_names = ap_names; }
+
+            ///
+            /// \fn     fail
+            /// \brief  Records why, and where, the file failed. Only the first failure is kept.
+            ///
+            inline Boolean fail (const char* ap_reason)
+            {
+                if (mp_error == nullptr)
+                {
+                    mp_error = ap_reason;
+                    m_errorOffset = getOffset();
+                }
+
+                return false;
+            }
+
+            ///
+            /// \fn     stop
+            /// \brief  Records that a visitor stopped the walk.
+            ///
+            inline Boolean stop ()
+            {
+                m_stopped = true;
+                return false;
+            }
+
+            inline Boolean skip (const Size a_size)
+            {
+                if (a_size > getRemaining())
+                    return fail("Unexpected end of file.");
+
+                mp_cursor += a_size;
+                return true;
+            }
+
+            inline Boolean readByte (U8& a_data)
+            {
+                if (mp_cursor == mp_end)
+                    return fail("Unexpected end of file.");
+
+                a_data = *mp_cursor++;
+                return true;
+            }
+
+            ///
+            /// \fn     readFixed
+            /// \brief  Reads a big-endian integer of the given width.
+            ///
+            template <Size W>
+            inline Boolean readFixed (U32& a_data)
+            {
+                if (W > getRemaining())
+                    return fail("Unexpected end of file.");
+
+                U32 l_data = 0;
+                for (Size i = 0; i < W; ++i)
+                    l_data = (l_data << 8) | mp_cursor[i];
+
+                mp_cursor += W;
+                a_data = l_data;
+                return true;
+            }
+
+            ///
+            /// \fn     readVarint
+            /// \brief  Reads a variable-length integer, rejecting any longer than five bytes,
+            ///         or holding more than 32 bits.
+            ///
+            inline Boolean readVarint (U32& a_data)
+            {
+                U32 l_data = 0;
+                for (Size i = 0; i < 5; ++i)
+                {
+                    if (mp_cursor == mp_end)
+                        return fail("Truncated variable-length integer.");
+
+                    const U8 l_byte = *mp_cursor;
+                    if (i == 4 && l_byte >= 0x10)
+                        return fail("Overlong variable-length integer.");
+
+                    mp_cursor++;
+                    l_data |= static_cast<U32>(l_byte & 0x7F) << (7 * i);
+                    if (l_byte < 0x80)
+                        break;
+                }
+
+                a_data = l_data;
+                return true;
+            }
+
+            ///
+            /// \fn     readInteger
+            /// \brief  Reads a 16- or 32-bit integer in the file's format.
+            ///
+            template <Size W>
+            inline Boolean readInteger (U32& a_data)
+            {
+                return (m_compact == true) ? readVarint(a_data) : readFixed<W>(a_data);
+            }
+
+            inline Boolean readHeader (U32& a_header)
+            {
+                if (m_compact == false)
+                    return readFixed<sizeof(U32)>(a_header);
+
+                U8 l_tag = 0;
+                if (readByte(l_tag) == false)
+                    return false;
+
+                switch (l_tag)
+                {
+                case G_ENTRY_TAG:   a_header = G_ENTRY_HEADER;   return true;
+                case G_KEY_TAG:     a_header = G_KEY_HEADER;     return true;
+                case G_COLUMNS_TAG: a_header = G_COLUMNS_HEADER; return true;
+                default:            return fail("Unrecognized record tag.");
+                }
+            }
+
+            ///
+            /// \fn     readString
+            /// \brief  Skips a length-prefixed string, no longer than the given length.
+            ///
+            inline Boolean readString (const U32 a_maxLength,
+                                       U32& a_length,
+                                       const U8*& ap_bytes)
+            {
+                if (readInteger<sizeof(U32)>(a_length) == false)
+                    return false;
+
+                if (a_length > a_maxLength)
+                    return fail("String longer than allowed.");
+
+                ap_bytes = mp_cursor;
+                return skip(a_length);
+            }
+
+            ///
+            /// \fn     readName
+            /// \brief  Skips the name of a key or entry, which must not be empty.
+            ///
+            /// \param  a_isKey     Set if the name is a key's, which must not be reserved.
+            /// \param  a_length    Filled with the length of the name.
+            /// \param  ap_bytes    Filled with the name's first byte. Left null for an index
+            ///                     into the name table, unless the table's names were given.
+            ///
+            inline Boolean readName (const U32 a_maxLength,
+                                     const Boolean a_isKey,
+                                     U32& a_length,
+                                     const U8*& ap_bytes)
+            {
+                if (m_nameTable == true)
+                {
+                    U32 l_index = 0;
+                    if (readVarint(l_index) == false)
+                        return false;
+
+                    if (l_index >= m_nameCount)
+                        return fail("Name index out of range.");
+
+                    if (mp_names != nullptr)
+                    {
+                        a_length = mp_names[l_index].m_length;
+                        ap_bytes = mp_names[l_index].mp_bytes;
+                    }
+
+                    return true;
+                }
+
+                if (readString(a_maxLength, a_length, ap_bytes) == false)
+                    return false;
+
+                if (a_length == 0)
+                    return fail("Empty name.");
+
+                if (a_isKey == true && a_length == 4 &&
+                    (std::equal(ap_bytes, ap_bytes + 4, "root") == true ||
+                     std::equal(ap_bytes, ap_bytes + 4, "null") == true))
+                    return fail("Reserved key name.");
+
+                return true;
+            }
+
+            ///
+            /// \fn     readValue
+            /// \brief  Skips a value of the given type.
+            ///
+            inline Boolean readValue (const U8 a_alias,
+                                      const U32 a_maxStringLength)
+            {
+                U32 l_data = 0;
+                const U8* lp_bytes = nullptr;
+
+                switch (a_alias)
+                {
+                case Datatypes::SignedByte:
+                case Datatypes::UnsignedByte:       return skip(1);
+                case Datatypes::SignedShort:
+                case Datatypes::UnsignedShort:      return readInteger<sizeof(U16)>(l_data);
+                case Datatypes::SignedInteger:
+                case Datatypes::UnsignedInteger:    return readInteger<sizeof(U32)>(l_data);
+                case Datatypes::FloatingPoint:      return skip(sizeof(U32));
+                case Datatypes::StringLiteral:      return readString(a_maxStringLength, l_data, lp_bytes);
+                default:                            return fail("Unrecognized type alias.");
+                }
+            }
+
+            ///
+            /// \fn     readValue
+            /// \brief  Reads a value of the given type into a record's view.
+            ///
+            inline Boolean readValue (const U8 a_alias,
+                                      const U32 a_maxStringLength,
+                                      RecordView& a_view)
+            {
+                U32 l_data = 0;
+                const U8* lp_bytes = mp_cursor;
+
+                switch (a_alias)
+                {
+                case Datatypes::SignedByte:
+                case Datatypes::UnsignedByte:
+                    if (skip(1) == false)
+                        return false;
+
+                    a_view.m_integer = extendInteger(a_alias, *lp_bytes);
+                    return true;
+                case Datatypes::SignedShort:
+                case Datatypes::UnsignedShort:
+                    if (readInteger<sizeof(U16)>(l_data) == false)
+                        return false;
+
+                    break;
+                case Datatypes::SignedInteger:
+                case Datatypes::UnsignedInteger:
+                    if (readInteger<sizeof(U32)>(l_data) == false)
+                        return false;
+
+                    break;
+                case Datatypes::FloatingPoint:
+                    if (skip(sizeof(U32)) == false)
+                        return false;
+
+                    std::memcpy(&l_data, lp_bytes, sizeof(U32));
+                    a_view.m_float = decodeFloat(l_data);
+                    return true;
+                case Datatypes::StringLiteral:
+                    if (readString(a_maxStringLength, l_data, lp_bytes) == false)
+                        return false;
+
+                    a_view.mp_string = reinterpret_cast<const char*>(lp_bytes);
+                    a_view.m_stringLength = l_data;
+                    return true;
+                default:
+                    return fail("Unrecognized type alias.");
+                }
+
+                // Signed integers are zigzag-encoded in the compact layout.
+                if (m_compact == true &&
+                    (a_alias == Datatypes::SignedShort || a_alias == Datatypes::SignedInteger))
+                    l_data = static_cast<U32>(decodeZigzag(l_data));
+
+                a_view.m_integer = extendInteger(a_alias, l_data);
+                return true;
+            }
+
+        };
+
+        ///
+        /// \fn     isValidAlias
+        /// \brief  Checks whether a byte is one of the type aliases.
+        ///
+        static inline Boolean isValidAlias (const U8 a_alias)
+        {
+            return a_alias >= Datatypes::SignedByte && a_alias <= Datatypes::StringLiteral;
+        }
+
+        ///
+        /// \fn     isIntegerAlias
+        /// \brief  Checks whether a type alias names a 16- or 32-bit integer, which
+        ///         can be delta-encoded in a column.
+        ///
+        static inline Boolean isIntegerAlias (const U8 a_alias)
+        {
+            return a_alias == Datatypes::SignedShort   || a_alias == Datatypes::SignedInteger ||
+                   a_alias == Datatypes::UnsignedShort || a_alias == Datatypes::UnsignedInteger;
+        }
+
+        ///
+        /// \fn     setName
+        /// \brief  Points a record's view at its name.
+        ///
+        static inline void setName (RecordView& a_view,
+                                    const U8* ap_bytes,
+                                    const U32 a_length)
+        {
+            a_view.mp_name = reinterpret_cast<const char*>(ap_bytes);
+            a_view.m_nameLength = a_length;
+        }
+
+        ///
+        /// \fn     visitColumns
+        /// \brief  Passes the rows of a checked block of columns to a visitor.
+        ///
+        /// \param  a_block         The block, as it was read.
+        /// \param  a_schema        A scanner at the start of the block's schema.
+        /// \param  a_columns       A scanner at the start of each column's values.
+        ///
+        static Boolean visitColumns (Scanner& a_scanner,
+                                     const ValidationLimits& a_limits,
+                                     RecordVisitor& a_visitor,
+                                     const RecordView& a_block,
+                                     const Scanner& a_schema,
+                                     std::vector<Scanner>& a_columns)
+        {
+            std::vector<U32> l_previous(a_columns.size(), 0);
+
+            for (U32 r = 0; r < a_block.m_rowCount; ++r)
+            {
+                if (a_visitor.enterKey(a_block) == false)
+                    return a_scanner.stop();
+
+                Scanner l_schema = a_schema;
+                for (Size c = 0; c < a_columns.size(); ++c)
+                {
+                    RecordView l_entry {};
+                    l_entry.m_offset = a_block.m_offset;
+                    l_entry.m_depth = a_block.m_depth + 1;
+                    l_entry.m_rowCount = a_block.m_rowCount;
+
+                    U32 l_length = 0;
+                    const U8* lp_name = nullptr;
+                    U8 l_encoding = 0;
+                    l_schema.readName(a_limits.m_maxNameLength, false, l_length, lp_name);
+                    l_schema.readByte(l_entry.m_alias);
+                    l_schema.readByte(l_encoding);
+                    setName(l_entry, lp_name, l_length);
+
+                    // Delta-encoded values are written as signed 32-bit integers, each
+                    // the difference from the value in the row before.
+                    if (l_encoding == 1)
+                    {
+                        a_columns[c].readValue(Datatypes::SignedInteger, a_limits.m_maxStringLength, l_entry);
+                        l_previous[c] += l_entry.m_integer;
+                        l_entry.m_integer = extendInteger(l_entry.m_alias, l_previous[c]);
+                    }
+                    else
+                        a_columns[c].readValue(l_entry.m_alias, a_limits.m_maxStringLength, l_entry);
+
+                    if (a_visitor.visitEntry(l_entry) == false)
+                        return a_scanner.stop();
+                }
+
+                if (a_visitor.leaveKey(a_block, a_scanner.getOffset()) == false)
+                    return a_scanner.stop();
+            }
+
+            return true;
+        }
+
+        ///
+        /// \fn     scanColumns
+        /// \brief  Checks a block of columns, just after its header.
+        ///
+        /// \param  a_block         The block's view, with its offset and depth set.
+        ///                         The rest is filled in as the block is read.
+        /// \param  ap_visitor      The visitor to pass the block's rows to, or null.
+        ///
+        static Boolean scanColumns (Scanner& a_scanner,
+                                    const ValidationLimits& a_limits,
+                                    RecordView& a_block,
+                                    RecordVisitor* ap_visitor)
+        {
+            U32 l_rowCount = 0, l_columnCount = 0, l_length = 0;
+            const U8* lp_name = nullptr;
+            if (a_scanner.readName(a_limits.m_maxNameLength, true, l_length, lp_name) == false ||
+                a_scanner.readInteger<sizeof(U32)>(l_rowCount) == false ||
+                a_scanner.readInteger<sizeof(U32)>(l_columnCount) == false)
+                return false;
+
+            // Every value takes at least one byte.
+            if (l_columnCount == 0 || l_rowCount > a_scanner.getRemaining() / l_columnCount)
+                return a_scanner.fail("Invalid column dimensions.");
+
+            setName(a_block, lp_name, l_length);
+            a_block.m_rowCount = l_rowCount;
+
+            // Check the schema, remembering where it starts. The values are laid out
+            // one column at a time, so the schema is walked again alongside them,
+            // rather than being copied anywhere.
+            const Scanner l_start = a_scanner;
+            for (U32 c = 0; c < l_columnCount; ++c)
+            {
+                U8 l_alias = 0, l_encoding = 0;
+                if (a_scanner.readName(a_limits.m_maxNameLength, false, l_length, lp_name) == false ||
+                    a_scanner.readByte(l_alias) == false ||
+                    a_scanner.readByte(l_encoding) == false)
+                    return false;
+
+                if (isValidAlias(l_alias) == false)
+                    return a_scanner.fail("Unrecognized column type alias.");
+
+                if (l_encoding > 1 || (l_encoding == 1 && isIntegerAlias(l_alias) == false))
+                    return a_scanner.fail("Unrecognized column encoding.");
+            }
+
+            // A visitor is given the block a row at a time, so it needs to know
+            // where each column's values start.
+            std::vector<Scanner> l_columns;
+            if (ap_visitor != nullptr)
+                l_columns.reserve(l_columnCount);
+
+            Scanner l_schema = l_start;
+            for (U32 c = 0; c < l_columnCount; ++c)
+            {
+                U8 l_alias = 0, l_encoding = 0;
+                l_schema.readName(a_limits.m_maxNameLength, false, l_length, lp_name);
+                l_schema.readByte(l_alias);
+                l_schema.readByte(l_encoding);
+
+                // Delta-encoded values are written as signed 32-bit integers.
+                if (l_encoding == 1)
+                    l_alias = Datatypes::SignedInteger;
+
+                if (ap_visitor != nullptr)
+                    l_columns.push_back(a_scanner);
+
+                for (U32 r = 0; r < l_rowCount; ++r)
+                {
+                    if (a_scanner.readValue(l_alias, a_limits.m_maxStringLength) == false)
+                        return false;
+                }
+            }
+
+            if (ap_visitor == nullptr)
+                return true;
+
+            return visitColumns(a_scanner, a_limits, *ap_visitor, a_block, l_start, l_columns);
+        }
+
+        ///
+        /// \fn     scanRegistry
+        /// \brief  Checks a whole registry file, passing its records to a visitor if one is given.
+        ///
+        /// Keys are walked with an explicit stack of the records left in each open
+        /// key, so that no file, however deeply nested, can exhaust the real stack.
+        /// Plain validation is compiled separately, without any of the visiting.
+        ///
+        template <Boolean Visiting>
+        static Boolean scanRegistry (Scanner& a_scanner,
+                                     const ValidationLimits& a_limits,
+                                     RecordVisitor* ap_visitor)
+        {
+            const U32 l_maxDepth = std::min(a_limits.m_maxDepth, G_MAX_KEY_DEPTH);
+
+            // The file header is always written in the standard layout.
+            U32 l_header = 0, l_version = 0;
+            if (a_scanner.readFixed<sizeof(U32)>(l_header) == false ||
+                a_scanner.readFixed<sizeof(U16)>(l_version) == false)
+                return false;
+
+            if (l_header != G_REGISTRY_HEADER)
+                return a_scanner.fail("Invalid file header.");
+
+            if (l_version == G_VERSION_COMPACT)
+            {
+                U8 l_format = 0;
+                if (a_scanner.readByte(l_format) == false)
+                    return false;
+
+                const U8 l_known = Formats::Compact | Formats::NameTable | Formats::Columnar;
+                if ((l_format & Formats::Compact) == 0 || (l_format & ~l_known) != 0)
+                    return a_scanner.fail("Unsupported format flags.");
+
+                a_scanner.setFormat(l_format);
+            }
+            else if (l_version != G_VERSION)
+                return a_scanner.fail("Version mismatch.");
+
+            // Check the name table, if there is one. A visitor needs the names
+            // themselves, so they are kept in that case.
+            std::vector<NameSlice> l_names;
+            if (a_scanner.hasNameTable() == true)
+            {
+                U32 l_nameCount = 0;
+                if (a_scanner.readInteger<sizeof(U32)>(l_nameCount) == false)
+                    return false;
+
+                if (l_nameCount > a_scanner.getRemaining())
+                    return a_scanner.fail("Name table larger than the file.");
+
+                for (U32 i = 0; i < l_nameCount; ++i)
+                {
+                    U32 l_length = 0;
+                    const U8* lp_bytes = nullptr;
+                    if (a_scanner.readString(a_limits.m_maxNameLength, l_length, lp_bytes) == false)
+                        return false;
+
+                    if (l_length == 0)
+                        return a_scanner.fail("Empty name.");
+
+                    if (Visiting == true)
+                        l_names.push_back({ lp_bytes, l_length });
+                }
+
+                a_scanner.setNameCount(l_nameCount);
+                a_scanner.setNames(l_names.data());
+            }
+
+            // Now walk the records, starting with the root key's. Each open key's
+            // view is kept alongside its count, for the visitor.
+            U32 l_remaining[G_MAX_KEY_DEPTH + 1];
+            RecordView l_keys[G_MAX_KEY_DEPTH + 1];
+            U32 l_depth = 0;
+
+            if (a_scanner.readInteger<sizeof(U32)>(l_remaining[0]) == false)
+                return false;
+
+            if (l_remaining[0] > a_scanner.getRemaining())
+                return a_scanner.fail("Record count larger than the file.");
+
+            while (true)
+            {
+                if (l_remaining[l_depth] == 0)
+                {
+                    if (l_depth == 0)
+                        break;
+
+                    if (Visiting == true &&
+                        ap_visitor->leaveKey(l_keys[l_depth], a_scanner.getOffset()) == false)
+                        return a_scanner.stop();
+
+                    l_depth--;
+                    continue;
+                }
+
+                l_remaining[l_depth]--;
+
+                // Only fill in the record's view if there is a visitor to pass it to.
+                RecordView l_view;
+                if (Visiting == true)
+                {
+                    l_view = RecordView {};
+                    l_view.m_offset = a_scanner.getOffset();
+                    l_view.m_depth = l_depth;
+                }
+
+                U32 l_record = 0, l_length = 0;
+                const U8* lp_name = nullptr;
+                if (a_scanner.readHeader(l_record) == false)
+                    return false;
+
+                if (l_record == G_ENTRY_HEADER)
+                {
+                    U8 l_alias = 0;
+                    if (a_scanner.readName(a_limits.m_maxNameLength, false, l_length, lp_name) == false ||
+                        a_scanner.readByte(l_alias) == false ||
+                        ((Visiting == true) ? a_scanner.readValue(l_alias, a_limits.m_maxStringLength, l_view) :
+                                              a_scanner.readValue(l_alias, a_limits.m_maxStringLength)) == false)
+                        return false;
+
+                    if (Visiting == true)
+                    {
+                        l_view.m_alias = l_alias;
+                        setName(l_view, lp_name, l_length);
+                        if (ap_visitor->visitEntry(l_view) == false)
+                            return a_scanner.stop();
+                    }
+                }
+                else if (l_record == G_KEY_HEADER || l_record == G_COLUMNS_HEADER)
+                {
+                    if (l_depth + 1 > l_maxDepth)
+                        return a_scanner.fail("Keys nested deeper than allowed.");
+
+                    if (l_record == G_COLUMNS_HEADER)
+                    {
+                        if (scanColumns(a_scanner, a_limits, l_view, ap_visitor) == false)
+                            return false;
+
+                        continue;
+                    }
+
+                    U32 l_count = 0;
+                    if (a_scanner.readName(a_limits.m_maxNameLength, true, l_length, lp_name) == false ||
+                        a_scanner.readInteger<sizeof(U32)>(l_count) == false)
+                        return false;
+
+                    if (l_count > a_scanner.getRemaining())
+                        return a_scanner.fail("Record count larger than the file.");
+
+                    l_remaining[++l_depth] = l_count;
+
+                    if (Visiting == true)
+                    {
+                        setName(l_view, lp_name, l_length);
+                        l_keys[l_depth] = l_view;
+                        if (ap_visitor->enterKey(l_view) == false)
+                            return a_scanner.stop();
+                    }
+                }
+                else
+                    return a_scanner.fail("Invalid record header.");
+            }
+
+            if (a_scanner.getRemaining() != 0)
+                return a_scanner.fail("Unexpected bytes after the end of the registry.");
+
+            return true;
+        }
+
+    }
+
+    Status Validator::validate (const void *ap_data, const Size a_size, const ValidationLimits &a_limits,
+                                Size *ap_offset)
+    {
+        Private::Scanner l_scanner { ap_data, (ap_data == nullptr) ? 0 : a_size };
+        if (Private::scanRegistry<false>(l_scanner, a_limits, nullptr) == true)
+            return Status::OK;
+
+        _Nelobin_Error("Validator::validate(): " << l_scanner.getError() <<
+                       " At byte " << l_scanner.getErrorOffset() << ".");
+
+        if (ap_offset != nullptr)
+            *ap_offset = l_scanner.getErrorOffset();
+
+        return Status::FileParseError;
+    }
+
+    Status Validator::validate (const Buffer &a_buffer, const ValidationLimits &a_limits, Size *ap_offset)
+    {
+        return validate(a_buffer.getData(), a_buffer.getSize(), a_limits, ap_offset);
+    }
+
+    Status Validator::walk (const void *ap_data, const Size a_size, RecordVisitor &a_visitor,
+                            const ValidationLimits &a_limits, Size *ap_offset)
+    {
+        Private::Scanner l_scanner { ap_data, (ap_data == nullptr) ? 0 : a_size };
+        if (Private::scanRegistry<true>(l_scanner, a_limits, &a_visitor) == true ||
+            l_scanner.isStopped() == true)
+            return Status::OK;
+
+        _Nelobin_Error("Validator::walk(): " << l_scanner.getError() <<
+                       " At byte " << l_scanner.getErrorOffset() << ".");
+
+        if (ap_offset != nullptr)
+            *ap_offset = l_scanner.getErrorOffset();
+
+        return Status::FileParseError;
+    }
+
+}
@@ -0,0 +1,741 @@
+///
+/// \file   NbfTool.cpp
+/// \brief  The 'nbftool' program, which inspects registry files without loading them.
+///
+/// The file is mapped into memory and walked once, record by record, with the
+/// validator's 'walk' method, so nothing resembling a registry is ever built.
+/// Apart from the name table, and counts kept per distinct name, the program
+/// uses the same small amount of memory for a file of any size. The mapped
+/// pages belong to the page cache, which the system can reclaim at will.
+///
+/// Every command checks the file as it goes, and fails if it is malformed:
+///
+///   nbftool dump <file>               Prints the whole file as indented text.
+///   nbftool stat <file> [--top <n>]   Prints counts, depth, common names and large subtrees.
+///   nbftool get <file> <path>         Prints the entry or key at the given path.
+///   nbftool verify <file>             Only checks the file.
+///
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Nelobin/MappedFile.hpp>
+#include <Nelobin/Text.hpp>
+#include <Nelobin/Validator.hpp>
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+# include <sys/mman.h>
+#endif
+
+namespace NbfTool
+{
+
+    using namespace Nelobin;
+
+    /// The size at which printed text is written out.
+    static const Size G_CHUNK_SIZE = 64 * 1024;
+
+    ///
+    /// \class  Output
+    /// \brief  Gathers text into one reused chunk, writing it to stdout whenever it fills.
+    ///
+    class Output
+    {
+    private:
+        String      m_text;         ///< The text not yet written.
+        Boolean     m_failed;       ///< Did a write fail?
+
+    public:
+        Output () :
+            m_failed { false }
+        {
+            m_text.reserve(G_CHUNK_SIZE + 1024);
+        }
+
+        ~Output ()
+        {
+            flush();
+        }
+
+    public:
+        inline String& getText () { return m_text; }
+
+        ///
+        /// \fn     commit
+        /// \brief  Writes the chunk out if it has filled.
+        ///
+        /// \return False if writing failed.
+        ///
+        inline Boolean commit ()
+        {
+            return (m_text.size() < G_CHUNK_SIZE) ? true : flush();
+        }
+
+        Boolean flush ()
+        {
+            if (m_text.empty() == false && m_failed == false &&
+                std::fwrite(m_text.data(), 1, m_text.size(), stdout) != m_text.size())
+                m_failed = true;
+
+            m_text.clear();
+            return m_failed == false;
+        }
+    };
+
+    ///
+    /// \class  InstanceCounter
+    /// \brief  Works out the instance IDs of keys as they are walked.
+    ///
+    /// A key's instance ID is the number of keys of the same name before it in
+    /// its parent, so a count is kept for each name in each open key. The counts
+    /// of a key's subkeys are dropped once the key has been walked.
+    ///
+    class InstanceCounter
+    {
+    private:
+        std::vector<std::unordered_map<std::string_view, U32>> m_counts;
+
+    public:
+        InstanceCounter () :
+            m_counts(G_MAX_KEY_DEPTH + 1)
+        {}
+
+    public:
+        ///
+        /// \fn     enter
+        /// \brief  Counts a key as it is entered, returning its instance ID.
+        ///
+        inline U32 enter (const RecordView& a_key)
+        {
+            return m_counts[a_key.m_depth][std::string_view { a_key.mp_name, a_key.m_nameLength }]++;
+        }
+
+        ///
+        /// \fn     leave
+        /// \brief  Drops the counts of a key's subkeys as the key is left.
+        ///
+        inline void leave (const RecordView& a_key)
+        {
+            m_counts[a_key.m_depth + 1].clear();
+        }
+    };
+
+    ///
+    /// \fn     appendValue
+    /// \brief  Appends the text form of an entry's value, as 'dumpText' writes it.
+    ///
+    static void appendValue (String& a_text,
+                             const RecordView& a_entry)
+    {
+        switch (a_entry.m_alias)
+        {
+        case Datatypes::SignedByte:         Nelobin::appendValue(a_text, static_cast<S8>(a_entry.m_integer)); break;
+        case Datatypes::SignedShort:        Nelobin::appendValue(a_text, static_cast<S16>(a_entry.m_integer)); break;
+        case Datatypes::SignedInteger:      Nelobin::appendValue(a_text, static_cast<S32>(a_entry.m_integer)); break;
+        case Datatypes::UnsignedByte:       Nelobin::appendValue(a_text, static_cast<U8>(a_entry.m_integer)); break;
+        case Datatypes::UnsignedShort:      Nelobin::appendValue(a_text, static_cast<U16>(a_entry.m_integer)); break;
+        case Datatypes::UnsignedInteger:    Nelobin::appendValue(a_text, a_entry.m_integer); break;
+        case Datatypes::FloatingPoint:      Nelobin::appendValue(a_text, a_entry.m_float); break;
+        case Datatypes::StringLiteral:      appendQuoted(a_text, a_entry.mp_string, a_entry.m_stringLength); break;
+        default:                            break;
+        }
+    }
+
+    ///
+    /// \fn     appendEntryLine
+    /// \brief  Appends an entry's line of dumped text, at the given depth.
+    ///
+    static void appendEntryLine (String& a_text,
+                                 const RecordView& a_entry,
+                                 const Size a_depth)
+    {
+        a_text.append(a_depth * 4, ' ');
+        a_text.append(a_entry.mp_name, a_entry.m_nameLength);
+        a_text.append(" (");
+        a_text.append(getShortTypeName(a_entry.m_alias));
+        a_text.append(") = ");
+        appendValue(a_text, a_entry);
+        a_text.push_back('\n');
+    }
+
+    ///
+    /// \fn     appendKeyLine
+    /// \brief  Appends a key's line of dumped text, at the given depth.
+    ///
+    static void appendKeyLine (String& a_text,
+                               const RecordView& a_key,
+                               const U32 a_instance,
+                               const Size a_depth)
+    {
+        a_text.append(a_depth * 4, ' ');
+        a_text.push_back('[');
+        a_text.append(a_key.mp_name, a_key.m_nameLength);
+
+        if (a_instance != 0)
+        {
+            a_text.push_back(':');
+            Nelobin::appendValue(a_text, a_instance);
+        }
+
+        a_text.append("]\n");
+    }
+
+    ///
+    /// \class  DumpVisitor
+    /// \brief  Prints every record in the file, in the same text as 'dumpText'.
+    ///
+    class DumpVisitor : public RecordVisitor
+    {
+    private:
+        Output&             m_output;
+        InstanceCounter     m_instances;
+
+    public:
+        explicit DumpVisitor (Output& a_output) :
+            m_output { a_output }
+        {}
+
+    public:
+        Boolean enterKey (const RecordView& a_key) override
+        {
+            appendKeyLine(m_output.getText(), a_key, m_instances.enter(a_key), a_key.m_depth);
+            return m_output.commit();
+        }
+
+        Boolean leaveKey (const RecordView& a_key, const Size) override
+        {
+            m_instances.leave(a_key);
+            return true;
+        }
+
+        Boolean visitEntry (const RecordView& a_entry) override
+        {
+            appendEntryLine(m_output.getText(), a_entry, a_entry.m_depth);
+            return m_output.commit();
+        }
+    };
+
+    ///
+    /// \class  GetVisitor
+    /// \brief  Prints the entry, or the key and everything beneath it, at a path.
+    ///
+    /// The path is matched one component at a time, as keys are entered. Once
+    /// the key which held the last match is left, nothing further on can match,
+    /// so the walk is stopped there.
+    ///
+    class GetVisitor : public RecordVisitor
+    {
+    private:
+        struct Component
+        {
+            String      m_name;
+            U32         m_instance;
+        };
+
+        Output&                 m_output;
+        InstanceCounter         m_instances;
+        std::vector<Component>  m_components;   ///< The path's components.
+        U32                     m_matched;      ///< The number of components matched by open keys.
+        Boolean                 m_printing;     ///< Is the key at the path being printed?
+        U32                     m_printDepth;   ///< The depth of the key at the path.
+        Boolean                 m_found;        ///< Was anything found at the path?
+
+    public:
+        GetVisitor (Output& a_output,
+                    const String& a_path) :
+            m_output        { a_output },
+            m_matched       { 0 },
+            m_printing      { false },
+            m_printDepth    { 0 },
+            m_found         { false }
+        {
+            Size l_position = 0;
+            Component l_component;
+            while (nextPathComponent(a_path, l_position, l_component.m_name, l_component.m_instance) == true)
+                m_components.push_back(l_component);
+
+            // An empty path names the root, so print everything.
+            if (m_components.empty() == true)
+            {
+                m_printing = true;
+                m_found = true;
+            }
+        }
+
+    public:
+        inline Boolean isFound () const { return m_found; }
+
+        Boolean enterKey (const RecordView& a_key) override
+        {
+            const U32 l_instance = m_instances.enter(a_key);
+
+            if (m_printing == true)
+            {
+                appendKeyLine(m_output.getText(), a_key, l_instance, a_key.m_depth - m_printDepth);
+                return m_output.commit();
+            }
+
+            if (a_key.m_depth != m_matched || matches(a_key, l_instance) == false)
+                return true;
+
+            // The last component names this key, so print it, and everything
+            // beneath it, as 'dumpText' would.
+            if (++m_matched == m_components.size())
+            {
+                appendKeyLine(m_output.getText(), a_key, l_instance, 0);
+                m_printing = true;
+                m_printDepth = a_key.m_depth;
+                m_found = true;
+                return m_output.commit();
+            }
+
+            return true;
+        }
+
+        Boolean leaveKey (const RecordView& a_key, const Size) override
+        {
+            m_instances.leave(a_key);
+
+            if (m_printing == true && m_components.empty() == false && a_key.m_depth == m_printDepth)
+                return false;
+
+            // Leaving a key which matched means the rest of the path can't match.
+            return m_printing == true || a_key.m_depth + 1 != m_matched;
+        }
+
+        Boolean visitEntry (const RecordView& a_entry) override
+        {
+            if (m_printing == true)
+            {
+                appendEntryLine(m_output.getText(), a_entry, a_entry.m_depth - m_printDepth);
+                return m_output.commit();
+            }
+
+            // Entries have no instances of their own, so only instance 0 names one.
+            if (a_entry.m_depth == m_matched && m_matched + 1 == m_components.size() &&
+                matches(a_entry, 0) == true)
+            {
+                appendEntryLine(m_output.getText(), a_entry, 0);
+                m_found = true;
+                return m_output.commit();
+            }
+
+            return true;
+        }
+
+    private:
+        inline Boolean matches (const RecordView& a_record,
+                                const U32 a_instance) const
+        {
+            const Component& l_component = m_components[m_matched];
+            return l_component.m_instance == a_instance &&
+                   std::string_view { a_record.mp_name, a_record.m_nameLength } == l_component.m_name;
+        }
+    };
+
+    ///
+    /// \class  StatVisitor
+    /// \brief  Gathers counts, names and subtree sizes.
+    ///
+    class StatVisitor : public RecordVisitor
+    {
+    public:
+        ///
+        /// \struct NameCount
+        /// \brief  The number of keys and entries with a name.
+        ///
+        struct NameCount
+        {
+            Size    m_keys = 0;
+            Size    m_entries = 0;
+        };
+
+        ///
+        /// \struct Subtree
+        /// \brief  The size of a key, or of a block of columns, and its path.
+        ///
+        struct Subtree
+        {
+            Size    m_bytes;
+            String  m_path;
+        };
+
+        Size    m_keys = 0;                 ///< The number of keys, not counting the root.
+        Size    m_rows = 0;                 ///< The number of those keys stored in blocks of columns.
+        Size    m_blocks = 0;               ///< The number of blocks of columns.
+        Size    m_entries = 0;              ///< The number of entries.
+        Size    m_types[Datatypes::StringLiteral + 1] = {}; ///< The number of entries of each type.
+        Size    m_stringBytes = 0;          ///< The total length of all string values.
+        Size    m_maxDepth = 0;             ///< The deepest nesting of keys.
+
+        std::unordered_map<std::string_view, NameCount> m_names;
+
+    private:
+        Size                    m_top;          ///< The number of largest subtrees to keep.
+        std::vector<Subtree>    m_largest;      ///< The largest subtrees, as a min-heap on size.
+        InstanceCounter         m_instances;
+        String                  m_path;         ///< The path to the key being walked.
+        std::vector<Size>       m_pathLengths;  ///< The length of the path before each open key.
+        Size                    m_blockRows;    ///< The number of rows of the current block walked so far.
+        U32                     m_blockFirst;   ///< The instance ID of the current block's first row.
+        U32                     m_blockLast;    ///< The instance ID of the current block's latest row.
+
+    public:
+        explicit StatVisitor (const Size a_top) :
+            m_top           { a_top },
+            m_blockRows     { 0 },
+            m_blockFirst    { 0 },
+            m_blockLast     { 0 }
+        {}
+
+    public:
+        ///
+        /// \fn     getLargest
+        /// \brief  Gets the largest subtrees, largest first.
+        ///
+        std::vector<Subtree> getLargest () const
+        {
+            std::vector<Subtree> l_largest = m_largest;
+            std::sort(l_largest.begin(), l_largest.end(), [] (const Subtree& a, const Subtree& b)
+            {
+                return a.m_bytes > b.m_bytes;
+            });
+
+            return l_largest;
+        }
+
+        Boolean enterKey (const RecordView& a_key) override
+        {
+            const U32 l_instance = m_instances.enter(a_key);
+
+            m_keys++;
+            m_maxDepth = std::max<Size>(m_maxDepth, a_key.m_depth + 1);
+            m_names[std::string_view { a_key.mp_name, a_key.m_nameLength }].m_keys++;
+
+            if (a_key.m_rowCount != 0)
+            {
+                m_rows++;
+                if (m_blockRows++ == 0)
+                {
+                    m_blocks++;
+                    m_blockFirst = l_instance;
+                }
+
+                m_blockLast = l_instance;
+            }
+
+            m_pathLengths.push_back(m_path.size());
+            m_path.push_back('/');
+            m_path.append(a_key.mp_name, a_key.m_nameLength);
+
+            if (l_instance != 0)
+            {
+                m_path.push_back(':');
+                Nelobin::appendValue(m_path, l_instance);
+            }
+
+            return true;
+        }
+
+        Boolean leaveKey (const RecordView& a_key, const Size a_end) override
+        {
+            m_instances.leave(a_key);
+
+            // The rows of a block of columns share its bytes, so the block is
+            // counted as a whole, as a range of instances, after its last row.
+            if (a_key.m_rowCount == 0)
+                addSubtree(a_end - a_key.m_offset);
+            else if (m_blockRows == a_key.m_rowCount)
+            {
+                m_path.resize(m_pathLengths.back() + 1);
+                m_path.append(a_key.mp_name, a_key.m_nameLength);
+                m_path.push_back(':');
+                Nelobin::appendValue(m_path, m_blockFirst);
+                m_path.push_back('-');
+                Nelobin::appendValue(m_path, m_blockLast);
+                m_path.append(" (columns)");
+                addSubtree(a_end - a_key.m_offset);
+                m_blockRows = 0;
+            }
+
+            m_path.resize(m_pathLengths.back());
+            m_pathLengths.pop_back();
+            return true;
+        }
+
+        Boolean visitEntry (const RecordView& a_entry) override
+        {
+            m_entries++;
+            m_types[a_entry.m_alias]++;
+            m_names[std::string_view { a_entry.mp_name, a_entry.m_nameLength }].m_entries++;
+
+            if (a_entry.m_alias == Datatypes::StringLiteral)
+                m_stringBytes += a_entry.m_stringLength;
+
+            return true;
+        }
+
+    private:
+        void addSubtree (const Size a_bytes)
+        {
+            auto l_compare = [] (const Subtree& a, const Subtree& b) { return a.m_bytes > b.m_bytes; };
+
+            if (m_largest.size() < m_top)
+            {
+                m_largest.push_back({ a_bytes, m_path });
+                std::push_heap(m_largest.begin(), m_largest.end(), l_compare);
+            }
+            else if (m_top != 0 && a_bytes > m_largest.front().m_bytes)
+            {
+                std::pop_heap(m_largest.begin(), m_largest.end(), l_compare);
+                m_largest.back() = { a_bytes, m_path };
+                std::push_heap(m_largest.begin(), m_largest.end(), l_compare);
+            }
+        }
+    };
+
+    ///
+    /// \fn     getLimits
+    /// \brief  Gets the limits a file is checked against. Files are inspected as
+    ///         deep as the validator allows.
+    ///
+    static ValidationLimits getLimits ()
+    {
+        ValidationLimits l_limits;
+        l_limits.m_maxDepth = G_MAX_KEY_DEPTH;
+        return l_limits;
+    }
+
+    ///
+    /// \fn     openFile
+    /// \brief  Maps a registry file, to be read from start to end.
+    ///
+    static Boolean openFile (MappedFile& a_file,
+                             const char* ap_filename)
+    {
+        if (a_file.open(ap_filename) != Status::OK)
+        {
+            std::fprintf(stderr, "nbftool: Could not open '%s'.\n", ap_filename);
+            return false;
+        }
+
+#if !defined(_WINDOWS) && !defined(_WIN32)
+        // The file is read once, in order, so let the system read ahead, and
+        // drop the pages already read first.
+        posix_madvise(a_file.getData(), a_file.getSize(), POSIX_MADV_SEQUENTIAL);
+#endif
+
+        return true;
+    }
+
+    ///
+    /// \fn     walkFile
+    /// \brief  Walks a mapped file with the given visitor, reporting where it is malformed.
+    ///
+    static Boolean walkFile (const MappedFile& a_file,
+                             const char* ap_filename,
+                             RecordVisitor& a_visitor)
+    {
+        Size l_offset = 0;
+        if (Validator::walk(a_file.getData(), a_file.getSize(), a_visitor, getLimits(), &l_offset) != Status::OK)
+        {
+            std::fprintf(stderr, "nbftool: '%s' is malformed at byte %zu.\n", ap_filename, static_cast<size_t>(l_offset));
+            return false;
+        }
+
+        return true;
+    }
+
+    ///
+    /// \fn     describeFormat
+    /// \brief  Describes the layout of a file which has passed validation.
+    ///
+    static String describeFormat (const MappedFile& a_file)
+    {
+        const U8* lp_bytes = reinterpret_cast<const U8*>(a_file.getData());
+        const U16 l_version = static_cast<U16>((lp_bytes[4] << 8) | lp_bytes[5]);
+        if (l_version != G_VERSION_COMPACT)
+            return "standard";
+
+        String l_format = "compact";
+        if ((lp_bytes[6] & Formats::NameTable) != 0)
+            l_format += ", name table";
+        if ((lp_bytes[6] & Formats::Columnar) != 0)
+            l_format += ", columnar";
+
+        return l_format;
+    }
+
+    static int runDump (const char* ap_filename)
+    {
+        MappedFile l_file;
+        if (openFile(l_file, ap_filename) == false)
+            return 1;
+
+        Output l_output;
+        DumpVisitor l_visitor { l_output };
+        const Boolean l_walked = walkFile(l_file, ap_filename, l_visitor);
+
+        return (l_walked == true && l_output.flush() == true) ? 0 : 1;
+    }
+
+    static int runGet (const char* ap_filename,
+                       const String& a_path)
+    {
+        MappedFile l_file;
+        if (openFile(l_file, ap_filename) == false)
+            return 1;
+
+        Output l_output;
+        GetVisitor l_visitor { l_output, a_path };
+        if (walkFile(l_file, ap_filename, l_visitor) == false || l_output.flush() == false)
+            return 1;
+
+        if (l_visitor.isFound() == false)
+        {
+            std::fprintf(stderr, "nbftool: Nothing found at '%s'.\n", a_path.c_str());
+            return 1;
+        }
+
+        return 0;
+    }
+
+    static int runStat (const char* ap_filename,
+                        const Size a_top)
+    {
+        MappedFile l_file;
+        if (openFile(l_file, ap_filename) == false)
+            return 1;
+
+        StatVisitor l_stats { a_top };
+        if (walkFile(l_file, ap_filename, l_stats) == false)
+            return 1;
+
+        std::printf("File:           %s\n", ap_filename);
+        std::printf("Size:           %zu bytes\n", static_cast<size_t>(l_file.getSize()));
+        std::printf("Format:         %s\n", describeFormat(l_file).c_str());
+        std::printf("Keys:           %zu\n", static_cast<size_t>(l_stats.m_keys));
+
+        if (l_stats.m_blocks != 0)
+            std::printf("  In columns:   %zu, in %zu blocks\n", static_cast<size_t>(l_stats.m_rows),
+                        static_cast<size_t>(l_stats.m_blocks));
+
+        std::printf("Entries:        %zu\n", static_cast<size_t>(l_stats.m_entries));
+        for (U8 l_alias = Datatypes::SignedByte; l_alias <= Datatypes::StringLiteral; ++l_alias)
+        {
+            if (l_stats.m_types[l_alias] != 0)
+                std::printf("  %-13s %zu\n", (String { getShortTypeName(l_alias) } + ":").c_str(),
+                            static_cast<size_t>(l_stats.m_types[l_alias]));
+        }
+
+        std::printf("String bytes:   %zu\n", static_cast<size_t>(l_stats.m_stringBytes));
+        std::printf("Maximum depth:  %zu\n", static_cast<size_t>(l_stats.m_maxDepth));
+        std::printf("Distinct names: %zu\n", static_cast<size_t>(l_stats.m_names.size()));
+
+        // The most common names, by the number of keys and entries using them.
+        using NamePair = std::pair<std::string_view, StatVisitor::NameCount>;
+        std::vector<NamePair> l_names { l_stats.m_names.begin(), l_stats.m_names.end() };
+        const Size l_nameCount = std::min(a_top, l_names.size());
+
+        std::partial_sort(l_names.begin(), l_names.begin() + l_nameCount, l_names.end(),
+            [] (const NamePair& a, const NamePair& b)
+            {
+                const Size l_a = a.second.m_keys + a.second.m_entries;
+                const Size l_b = b.second.m_keys + b.second.m_entries;
+                return (l_a != l_b) ? (l_a > l_b) : (a.first < b.first);
+            });
+
+        if (l_nameCount != 0)
+        {
+            std::printf("\nMost common names:\n%12s %12s  %s\n", "Keys", "Entries", "Name");
+            for (Size i = 0; i < l_nameCount; ++i)
+                std::printf("%12zu %12zu  %.*s\n", static_cast<size_t>(l_names[i].second.m_keys),
+                            static_cast<size_t>(l_names[i].second.m_entries),
+                            static_cast<int>(l_names[i].first.size()), l_names[i].first.data());
+        }
+
+        const auto l_largest = l_stats.getLargest();
+        if (l_largest.empty() == false)
+        {
+            std::printf("\nLargest subtrees:\n%12s  %s\n", "Bytes", "Path");
+            for (const auto& l_subtree : l_largest)
+                std::printf("%12zu  %s\n", static_cast<size_t>(l_subtree.m_bytes), l_subtree.m_path.c_str());
+        }
+
+        return 0;
+    }
+
+    static int runVerify (const char* ap_filename)
+    {
+        MappedFile l_file;
+        if (openFile(l_file, ap_filename) == false)
+            return 1;
+
+        Size l_offset = 0;
+        if (Validator::validate(l_file.getData(), l_file.getSize(), getLimits(), &l_offset) != Status::OK)
+        {
+            std::fprintf(stderr, "nbftool: '%s' is malformed at byte %zu.\n", ap_filename, static_cast<size_t>(l_offset));
+            return 1;
+        }
+
+        std::printf("%s: OK\n", ap_filename);
+        return 0;
+    }
+
+    static void printUsage ()
+    {
+        std::fprintf(stderr,
+            "Usage: nbftool <command> <file> [arguments]\n"
+            "  dump <file>              Print the whole file as indented text.\n"
+            "  stat <file> [--top <n>]  Print counts, depth, the n most common names and the n\n"
+            "                           largest subtrees, in bytes. Default: 10.\n"
+            "  get <file> <path>        Print the entry or key at the given path, such as\n"
+            "                           \"Servers/Server:2/Port\".\n"
+            "  verify <file>            Check that the file is well-formed.\n"
+            "Files are read as they are walked, and are never loaded whole.\n");
+    }
+
+}
+
+int main (int argc, char** argv)
+{
+    using namespace NbfTool;
+
+    if (argc < 3)
+    {
+        printUsage();
+        return 2;
+    }
+
+    const String l_command = argv[1];
+    const char* lp_filename = argv[2];
+
+    if (l_command == "dump" && argc == 3)
+        return runDump(lp_filename);
+    else if (l_command == "get" && argc == 4)
+        return runGet(lp_filename, argv[3]);
+    else if (l_command == "verify" && argc == 3)
+        return runVerify(lp_filename);
+    else if (l_command == "stat" && (argc == 3 || argc == 5))
+    {
+        Size l_top = 10;
+        if (argc == 5)
+        {
+            char* lp_end = nullptr;
+            l_top = std::strtoull(argv[4], &lp_end, 10);
+            if (String { argv[3] } != "--top" || lp_end == argv[4] || *lp_end != '\0')
+            {
+                printUsage();
+                return 2;
+            }
+        }
+
+        return runStat(lp_filename, l_top);
+    }
+
+    printUsage();
+    return 2;
+}